@@ -0,0 +1,225 @@
+/**
+ * Name:
+ *      Admission.c
+ *
+ * Desc:
+ *      Implementation of Admission.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Processes are admitted in the order they were read. A process that
+ *      doesn't fit holds back the ones after it, so big processes are not
+ *      starved by a stream of small ones. The footprint of a process is
+ *      the sum of its M(allocate) sizes. A process bigger than the whole
+ *      memory is admitted once nothing else is live, and fails or swaps
+ *      on its own.
+ */
+
+// Include guard
+#ifndef ADMISSION_C
+#define ADMISSION_C
+
+// Include header
+#include "Admission.h"
+#include "ProcessPcb.h"
+
+// Admission state
+static int admissionOn = 0;
+static int limit = 0;
+static long long memoryAvailable = 0;
+static long long *footprints = NULL;
+static int nextProcess = 0;
+static int liveCount = 0;
+static long long liveMemory = 0;
+
+// Statistics
+static int maxLive = 0;
+static long long totalWait = 0;
+static long long maxWait = 0;
+static long long startTime = 0;
+
+static long long programFootprint( const struct pcb *process )
+{
+    /**
+     * Desc:
+     *      Memory a process declares with its M(allocate) ops, counting
+     *      the ops in a repeat group once per run of the group. The
+     *      parser rejects programs whose repeat counts don't multiply out
+     *      into a long long, so none of this can overflow.
+     *
+     * Args:
+     *      process (const struct pcb*): process that hasn't started yet
+     *
+     * Returns:
+     *      The footprint in KB.
+     */
+    long long footprint = 0;
+    long long runs[META_MAX_REPEAT_DEPTH + 1] = { 1 };
+    int depth = 0;
+
+    for( int opIndex = 0; ( opIndex ) < ( process->program->opCount );
+         opIndex++ )
+    {
+        const struct MetaOp *op = &process->metaDataPointer[opIndex];
+
+        if( ( op->component ) == ( 'M' ) && ( op->opCode ) == ( OP_ALLOCATE ) )
+        {
+            footprint += op->cycles % 1000 * runs[depth];
+        }
+        else if( ( op->component ) == ( 'R' ) && ( op->opCode ) == ( OP_START ) )
+        {
+            runs[depth + 1] = runs[depth] * op->cycles;
+            depth++;
+        }
+        else if( ( op->component ) == ( 'R' ) )
+        {
+            depth--;
+        }
+    }
+
+    return footprint;
+}
+
+// Begin implementation
+int admissionEnabled( void )
+{
+    /**
+     * Desc:
+     *      Whether processes wait to be admitted.
+     *
+     * Returns:
+     *      1 if admission control is on, otherwise 0.
+     */
+    return admissionOn;
+}
+
+void admissionStart( CfgData *data, struct SimContext *context )
+{
+    /**
+     * Desc:
+     *      Set up admission for a run and work out every footprint,
+     *      dropping any previous statistics.
+     *
+     * Args:
+     *      data (CfgData*): config holding the limit and memory available
+     *      context (struct SimContext*): run state with the New processes
+     */
+    admissionFree();
+
+    admissionOn = data->admissionControl;
+    limit = data->multiprogrammingLimit;
+    memoryAvailable = data->memAvailable;
+    nextProcess = 0;
+    liveCount = 0;
+    liveMemory = 0;
+    maxLive = 0;
+    totalWait = 0;
+    maxWait = 0;
+    startTime = simulatedTime();
+
+    if( ( admissionOn ) == ( 0 ) )
+    {
+        return;
+    }
+
+    footprints = malloc( sizeof( long long ) *
+                         ( context->arraySize > 0 ? context->arraySize : 1 ) );
+    for( int index = 0; ( index ) < ( context->arraySize ); index++ )
+    {
+        footprints[index] = programFootprint( &context->pcbArray[index] );
+    }
+}
+
+void admitProcesses( struct SimContext *context )
+{
+    /**
+     * Desc:
+     *      Move New processes to Ready and hand them to the scheduler, in
+     *      order, while the next one fits.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     */
+    while( ( nextProcess ) < ( context->arraySize ) )
+    {
+        struct pcb *process = &context->pcbArray[nextProcess];
+        long long footprint = footprints[nextProcess];
+        long long wait = simulatedTime() - startTime;
+
+        if( ( liveCount ) > ( 0 ) &&
+            ( ( ( limit ) > ( 0 ) && ( liveCount ) >= ( limit ) ) ||
+              ( liveMemory + footprint ) > ( memoryAvailable ) ) )
+        {
+            return;
+        }
+
+        liveCount++;
+        liveMemory += footprint;
+        totalWait += wait;
+
+        if( ( liveCount ) > ( maxLive ) )
+        {
+            maxLive = liveCount;
+        }
+
+        if( ( wait ) > ( maxWait ) )
+        {
+            maxWait = wait;
+        }
+
+        logStateChange( process, STATE_READY, context->data, context->logFile,
+            context->logLine, context->timeBuffer );
+        PROFILE_ENTER( PROFILE_SCHED_DECISION );
+        context->scheduler->enqueue( context->schedulerState, nextProcess );
+        PROFILE_LEAVE( PROFILE_SCHED_DECISION );
+        nextProcess++;
+    }
+}
+
+void admissionRelease( int processIndex )
+{
+    /**
+     * Desc:
+     *      Give back the slot and memory of a process that exited.
+     *
+     * Args:
+     *      processIndex (int): index of the process
+     */
+    liveCount--;
+    liveMemory -= footprints[processIndex];
+}
+
+void admissionPrintStats( void )
+{
+    /**
+     * Desc:
+     *      Print how long processes waited to be admitted and the most
+     *      processes that were live at once.
+     */
+    printf( "\n___________ADMISSION STATS___________\n" );
+    printf( "Admitted            : %d\n", nextProcess );
+    printf( "Max Live            : %d\n", maxLive );
+
+    if( ( nextProcess ) > ( 0 ) )
+    {
+        printf( "Mean Admission Wait : %.3f mSec\n",
+                (double) totalWait / nextProcess / 1000 );
+    }
+
+    printf( "Max Admission Wait  : %.3f mSec\n", maxWait / 1000.0 );
+}
+
+void admissionFree( void )
+{
+    /**
+     * Desc:
+     *      Free the footprint table.
+     */
+    free( footprints );
+    footprints = NULL;
+}
+
+// End include guard
+#endif              // ADMISSION_C
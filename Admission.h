@@ -0,0 +1,35 @@
+/**
+ * Name:
+ *      Admission.h
+ *
+ * Desc:
+ *      Long term scheduler. Processes stay New until they are admitted,
+ *      which keeps the number of live processes under the multiprogramming
+ *      limit and their declared memory within the memory available.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// Defined in ProcessPcb.h
+struct SimContext;
+
+// Function headers
+int admissionEnabled( void );
+void admissionStart( CfgData *data, struct SimContext *context );
+void admitProcesses( struct SimContext *context );
+void admissionRelease( int processIndex );
+void admissionPrintStats( void );
+void admissionFree( void );
+
+// End include guard
+#endif              // ADMISSION_H
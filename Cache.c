@@ -0,0 +1,321 @@
+/**
+ * Name:
+ *      Cache.c
+ *
+ * Desc:
+ *      Implementation of Cache.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      There is one hierarchy per run, kept in this file the same way
+ *      Device.c keeps its devices. Processes have their own address spaces,
+ *      so the process id is part of every tag and processes only meet in
+ *      the cache by evicting each other's lines. A line that misses a level
+ *      is filled into it, so every level holds the most recent lines.
+ */
+
+// Include guard
+#ifndef CACHE_C
+#define CACHE_C
+
+// Include header
+#include "Cache.h"
+
+// Hierarchy state
+static struct CacheLevel levels[CACHE_LEVEL_COUNT];
+static int levelCount = 0;
+static int lineShift = 0;
+static long long memoryLatency = 0;
+static long long useClock = 0;
+static long long carryNSec = 0;
+static struct CacheCounts *processCounts = NULL;
+static int processCapacity = 0;
+static struct CacheCounts globalCounts;
+static int levelNames[CACHE_LEVEL_COUNT];
+
+static struct CacheCounts *cacheCounts( int processId )
+{
+    /**
+     * Desc:
+     *      Counters of a process, growing the table the first time a
+     *      process shows up.
+     *
+     * Args:
+     *      processId (int): id of the process
+     *
+     * Returns:
+     *      The counters.
+     */
+    if( ( processId ) >= ( processCapacity ) )
+    {
+        int capacity = processCapacity > 0 ? processCapacity : 64;
+
+        while( ( capacity ) <= ( processId ) )
+        {
+            capacity *= 2;
+        }
+
+        processCounts = realloc( processCounts,
+                                 sizeof( struct CacheCounts ) * capacity );
+        memset( processCounts + processCapacity, 0,
+                sizeof( struct CacheCounts ) * ( capacity - processCapacity ) );
+        processCapacity = capacity;
+    }
+
+    return &processCounts[processId];
+}
+
+static int cacheLookup( struct CacheLevel *level, long long tag )
+{
+    /**
+     * Desc:
+     *      Look a line up in one level, filling it in place of the least
+     *      recently used line of its set on a miss.
+     *
+     * Args:
+     *      level (struct CacheLevel*): level to search
+     *      tag (long long): process and line address
+     *
+     * Returns:
+     *      1 on a hit, 0 on a miss.
+     */
+    struct CacheLine *set = level->lines +
+                            ( tag % level->setCount ) * level->ways;
+    struct CacheLine *victim = set;
+
+    useClock++;
+
+    for( int way = 0; ( way ) < ( level->ways ); way++ )
+    {
+        if( ( set[way].tag ) == ( tag ) )
+        {
+            set[way].lastUse = useClock;
+            return 1;
+        }
+
+        if( ( set[way].lastUse ) < ( victim->lastUse ) )
+        {
+            victim = &set[way];
+        }
+    }
+
+    victim->tag = tag;
+    victim->lastUse = useClock;
+    return 0;
+}
+
+static void printCounts( const char *name, int processId,
+                         const struct CacheCounts *counts )
+{
+    /**
+     * Desc:
+     *      Print one row of the cache statistics. Each level's hit rate is
+     *      out of the lookups that reached that level.
+     *
+     * Args:
+     *      name (const char*): row name
+     *      processId (int): appended to the name if not negative
+     *      counts (const struct CacheCounts*): counters to print
+     */
+    char rowName[32];
+    long long reached = counts->lookups;
+
+    if( ( processId ) >= ( 0 ) )
+    {
+        sprintf( rowName, "%s %d", name, processId );
+    }
+    else
+    {
+        sprintf( rowName, "%s", name );
+    }
+
+    printf( "%-12s %12lld", rowName, counts->lookups );
+
+    for( int level = 0; ( level ) < ( levelCount ); level++ )
+    {
+        long long hits = counts->hits[level];
+
+        printf( " %7.2f", reached > 0 ? 100.0 * hits / reached : 0.0 );
+        reached -= hits;
+    }
+
+    printf( " %12lld\n", reached );
+}
+
+// Begin implementation
+int cacheEnabled( void )
+{
+    /**
+     * Desc:
+     *      Whether M(access) ops are charged through the cache model.
+     *
+     * Returns:
+     *      1 if at least one cache level is configured, otherwise 0.
+     */
+    return levelCount > 0;
+}
+
+void cacheStart( CfgData *data )
+{
+    /**
+     * Desc:
+     *      Set up empty cache levels from the config, dropping any previous
+     *      contents and statistics. Levels with a size of 0 are left out, a
+     *      level too small for one full set gets a single set.
+     *
+     * Args:
+     *      data (CfgData*): config holding the cache settings
+     */
+    cacheFree();
+
+    lineShift = 0;
+    while( ( 1 << lineShift ) < ( data->cacheLineSize ) )
+    {
+        lineShift++;
+    }
+
+    for( int level = 0; ( level ) < ( CACHE_LEVEL_COUNT ); level++ )
+    {
+        struct CacheLevel *cache = &levels[levelCount];
+        long long lineCount;
+
+        if( ( data->cacheSize[level] ) <= ( 0 ) )
+        {
+            continue;
+        }
+
+        lineCount = (long long) data->cacheSize[level] * 1024 >> lineShift;
+        cache->ways = data->cacheWays[level];
+        cache->setCount = (int) ( lineCount / cache->ways );
+        if( ( cache->setCount ) < ( 1 ) )
+        {
+            cache->setCount = 1;
+        }
+
+        cache->latency = data->cacheLatency[level];
+        cache->lines = malloc( sizeof( struct CacheLine ) * cache->setCount *
+                               cache->ways );
+        for( long long line = 0; ( line ) < ( (long long) cache->setCount *
+                                              cache->ways ); line++ )
+        {
+            cache->lines[line].tag = -1;
+            cache->lines[line].lastUse = 0;
+        }
+
+        levelNames[levelCount] = level;
+        levelCount++;
+    }
+
+    memoryLatency = data->memoryLatency;
+    useClock = 0;
+    carryNSec = 0;
+    memset( &globalCounts, 0, sizeof( globalCounts ) );
+}
+
+long long cacheAccess( int processId, long long address, long long size )
+{
+    /**
+     * Desc:
+     *      Run every line of an access through the hierarchy. Each lookup
+     *      pays the latency of every level it reaches, and main memory if
+     *      no level holds the line.
+     *
+     * Args:
+     *      processId (int): id of the accessing process
+     *      address (long long): first byte of the access
+     *      size (long long): bytes accessed
+     *
+     * Returns:
+     *      Whole simulated microseconds the access took. The part of a
+     *      microsecond left over is carried into the next access.
+     */
+    struct CacheCounts *counts = cacheCounts( processId );
+    long long first = address >> lineShift;
+    long long last = ( address + ( size > 0 ? size : 1 ) - 1 ) >> lineShift;
+    long long elapsed = carryNSec;
+
+    for( long long line = first; ( line ) <= ( last ); line++ )
+    {
+        // Process id in the top bits, line address below
+        long long tag = ( (long long) processId << 40 ) | line;
+        int level = 0;
+
+        counts->lookups++;
+        globalCounts.lookups++;
+
+        while( ( level ) < ( levelCount ) )
+        {
+            elapsed += levels[level].latency;
+
+            if( cacheLookup( &levels[level], tag ) )
+            {
+                counts->hits[level]++;
+                globalCounts.hits[level]++;
+                break;
+            }
+
+            level++;
+        }
+
+        if( ( level ) == ( levelCount ) )
+        {
+            elapsed += memoryLatency;
+        }
+    }
+
+    carryNSec = elapsed % 1000;
+    return elapsed / 1000;
+}
+
+void cachePrintStats( void )
+{
+    /**
+     * Desc:
+     *      Print the hit rate of every level and the lines that went to
+     *      main memory, for each process that accessed memory and overall.
+     */
+    printf( "\n___________CACHE STATS___________\n" );
+    printf( "%-12s %12s", "Process", "Lookups" );
+
+    for( int level = 0; ( level ) < ( levelCount ); level++ )
+    {
+        char header[16];
+
+        sprintf( header, "%s Hit%%", CACHE_LEVEL_NAMES[levelNames[level]] );
+        printf( " %7s", header );
+    }
+
+    printf( " %12s\n", "Memory" );
+
+    for( int processId = 0; ( processId ) < ( processCapacity ); processId++ )
+    {
+        if( ( processCounts[processId].lookups ) > ( 0 ) )
+        {
+            printCounts( "Process", processId, &processCounts[processId] );
+        }
+    }
+
+    printCounts( "All", -1, &globalCounts );
+}
+
+void cacheFree( void )
+{
+    /**
+     * Desc:
+     *      Free the cache levels and the per process counters.
+     */
+    for( int level = 0; ( level ) < ( levelCount ); level++ )
+    {
+        free( levels[level].lines );
+    }
+
+    levelCount = 0;
+    free( processCounts );
+    processCounts = NULL;
+    processCapacity = 0;
+}
+
+// End include guard
+#endif              // CACHE_C
@@ -0,0 +1,56 @@
+/**
+ * Name:
+ *      Cache.h
+ *
+ * Desc:
+ *      Memory hierarchy model for M(access) ops. Up to three set
+ *      associative LRU cache levels sit in front of main memory, and every
+ *      access is charged the latency of the level that holds each line.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef CACHE_H
+#define CACHE_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// One cache line, tag is -1 when the line is empty
+struct CacheLine
+{
+    long long tag;
+    long long lastUse;
+};
+
+// Cache level state
+//      lines holds setCount sets of ways lines each. latency is paid by
+//      every lookup that reaches this level.
+struct CacheLevel
+{
+    int setCount;
+    int ways;
+    long long latency;
+    struct CacheLine *lines;
+};
+
+// Lookups per process, hits counts the lines found at each level
+struct CacheCounts
+{
+    long long lookups;
+    long long hits[CACHE_LEVEL_COUNT];
+};
+
+// Function headers
+int cacheEnabled( void );
+void cacheStart( CfgData *data );
+long long cacheAccess( int processId, long long address, long long size );
+void cachePrintStats( void );
+void cacheFree( void );
+
+// End include guard
+#endif              // CACHE_H
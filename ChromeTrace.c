@@ -0,0 +1,395 @@
+/**
+ * Name:
+ *      ChromeTrace.c
+ *
+ * Desc:
+ *      Implementation of ChromeTrace.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Only one timeline can be written at a time, the writer state is kept
+ *      in this file the same way EventTrace keeps its recorder state. Times
+ *      are simulated microseconds, the unit the format expects, so the
+ *      timeline does not depend on how long the host took.
+ */
+
+// Include guard
+#ifndef CHROMETRACE_C
+#define CHROMETRACE_C
+
+// Include header
+#include "ChromeTrace.h"
+
+// Per process timeline state
+//      Times are -1 when the process is not in that state. An op stays open
+//      across a preemption, opStart is reset when the process runs again.
+struct ChromeProcess
+{
+    int named;
+    long long readySince;
+    long long runningSince;
+    int opOpen;
+    long long opStart;
+    char component;
+    int opIndex;
+};
+
+// Writer state
+static FILE *chromeFile = NULL;
+static int chromeEventCount = 0;
+static struct ChromeProcess *chromeProcesses = NULL;
+static int chromeProcessCapacity = 0;
+static long long chromeAllReady = 0;
+static long long chromeNextFlow = 0;
+
+static void chromeBeginEvent( void )
+{
+    // Events are comma separated inside the traceEvents array
+    if( ( chromeEventCount ) > ( 0 ) )
+    {
+        fputs( ",\n", chromeFile );
+    }
+
+    chromeEventCount++;
+}
+
+static void chromeName( const char *kind, int pid, int tid, const char *name,
+                        int index )
+{
+    /**
+     * Desc:
+     *      Write a metadata event naming a trace process or thread.
+     *
+     * Args:
+     *      kind (const char*): "process_name" or "thread_name"
+     *      pid (int): trace process id
+     *      tid (int): trace thread id, ignored for process names
+     *      name (const char*): name to show
+     *      index (int): appended to the name if not negative
+     */
+    chromeBeginEvent();
+    fprintf( chromeFile, "{\"ph\":\"M\",\"name\":\"%s\",\"pid\":%d,"
+             "\"tid\":%d,\"args\":{\"name\":\"%s", kind, pid, tid, name );
+
+    if( ( index ) >= ( 0 ) )
+    {
+        fprintf( chromeFile, " %d", index );
+    }
+
+    fputs( "\"}}", chromeFile );
+}
+
+static void chromeSlice( int pid, int tid, const char *name, int nameIndex,
+                         long long start, long long end )
+{
+    /**
+     * Desc:
+     *      Write a complete slice.
+     *
+     * Args:
+     *      pid (int): trace process id
+     *      tid (int): trace thread id
+     *      name (const char*): slice name
+     *      nameIndex (int): appended to the name if not negative
+     *      start (long long): simulated start time
+     *      end (long long): simulated end time
+     */
+    chromeBeginEvent();
+    fprintf( chromeFile, "{\"ph\":\"X\",\"name\":\"%s", name );
+
+    if( ( nameIndex ) >= ( 0 ) )
+    {
+        fprintf( chromeFile, " %d", nameIndex );
+    }
+
+    fprintf( chromeFile, "\",\"pid\":%d,\"tid\":%d,\"ts\":%lld,\"dur\":%lld}",
+             pid, tid, start, end - start );
+}
+
+static struct ChromeProcess *chromeProcess( int processId )
+{
+    /**
+     * Desc:
+     *      Timeline state of a process, created and its track named the
+     *      first time the process shows up.
+     *
+     * Args:
+     *      processId (int): id of the process
+     *
+     * Returns:
+     *      The process state.
+     */
+    if( ( processId ) >= ( chromeProcessCapacity ) )
+    {
+        int capacity = chromeProcessCapacity > 0 ? chromeProcessCapacity : 64;
+
+        while( ( capacity ) <= ( processId ) )
+        {
+            capacity *= 2;
+        }
+
+        chromeProcesses = realloc( chromeProcesses,
+                                   sizeof( struct ChromeProcess ) * capacity );
+        for( int index = chromeProcessCapacity; ( index ) < ( capacity );
+             index++ )
+        {
+            chromeProcesses[index].named = 0;
+        }
+
+        chromeProcessCapacity = capacity;
+    }
+
+    struct ChromeProcess *process = &chromeProcesses[processId];
+
+    if( ( process->named ) == ( 0 ) )
+    {
+        process->named = 1;
+        process->readySince = chromeAllReady;
+        process->runningSince = -1;
+        process->opOpen = 0;
+        process->opStart = -1;
+        chromeName( "thread_name", CHROME_PID_PROCESSES, processId,
+                    "Process", processId );
+    }
+
+    return process;
+}
+
+static void chromeOpSlice( struct ChromeProcess *process, int processId,
+                           long long now )
+{
+    /**
+     * Desc:
+     *      Write the part of the open op that ran since opStart, on the
+     *      process track, and on the CPU track for ops that use the CPU.
+     *
+     * Args:
+     *      process (struct ChromeProcess*): process with an open op
+     *      processId (int): id of the process
+     *      now (long long): current simulated time
+     */
+    char name[32];
+
+    if( ( process->opStart ) < ( 0 ) )
+    {
+        return;
+    }
+
+    sprintf( name, "%c(%s)", process->component,
+             process->opIndex >= 0 ? META_LEGAL_OP_STRINGS[process->opIndex]
+                                   : "" );
+    chromeSlice( CHROME_PID_PROCESSES, processId, name, -1, process->opStart,
+                 now );
+
+    if( ( process->component ) == ( 'P' ) || ( process->component ) == ( 'M' ) )
+    {
+        chromeSlice( CHROME_PID_CPU, 0, name, -1, process->opStart, now );
+    }
+
+    process->opStart = -1;
+}
+
+static void chromeStateChange( struct ChromeProcess *process, int processId,
+                               int state, long long now )
+{
+    /**
+     * Desc:
+     *      Close the slices a state change ends and start the ones it
+     *      begins. Ready to Running is drawn as a flow arrow from the
+     *      process track to the CPU.
+     *
+     * Args:
+     *      process (struct ChromeProcess*): process changing state
+     *      processId (int): id of the process
+     *      state (int): PROCESS_STATES value of the new state
+     *      now (long long): current simulated time
+     */
+    if( ( state ) == ( STATE_RUNNING ) )
+    {
+        long long flow = chromeNextFlow++;
+
+        if( ( process->readySince ) >= ( 0 ) )
+        {
+            chromeSlice( CHROME_PID_PROCESSES, processId, "Ready", -1,
+                         process->readySince, now );
+            chromeBeginEvent();
+            fprintf( chromeFile, "{\"ph\":\"s\",\"name\":\"dispatch\","
+                     "\"cat\":\"sched\",\"id\":%lld,\"pid\":%d,\"tid\":%d,"
+                     "\"ts\":%lld}", flow, CHROME_PID_PROCESSES, processId,
+                     process->readySince );
+            chromeBeginEvent();
+            fprintf( chromeFile, "{\"ph\":\"f\",\"bp\":\"e\",\"name\":"
+                     "\"dispatch\",\"cat\":\"sched\",\"id\":%lld,\"pid\":%d,"
+                     "\"tid\":0,\"ts\":%lld}", flow, CHROME_PID_CPU, now );
+        }
+
+        process->readySince = -1;
+        process->runningSince = now;
+
+        // Pick a preempted op back up
+        if( process->opOpen )
+        {
+            process->opStart = now;
+        }
+
+        return;
+    }
+
+    if( ( process->runningSince ) >= ( 0 ) )
+    {
+        chromeSlice( CHROME_PID_CPU, 0, "Process", processId,
+                     process->runningSince, now );
+        process->runningSince = -1;
+    }
+
+    if( ( state ) == ( STATE_READY ) )
+    {
+        process->readySince = now;
+    }
+}
+
+// Begin implementation
+int chromeTraceOpen( char *tracePath, CfgData *data )
+{
+    /**
+     * Desc:
+     *      Start writing a timeline and name the CPU and device tracks.
+     *
+     * Args:
+     *      tracePath (char*): path of the JSON file to create
+     *      data (CfgData*): config holding the device channel counts
+     *
+     * Returns:
+     *      1 if the file was created, otherwise 0.
+     */
+    chromeFile = fopen( tracePath, "w" );
+    chromeEventCount = 0;
+    chromeAllReady = 0;
+    chromeNextFlow = 0;
+
+    if( ( chromeFile ) == ( NULL ) )
+    {
+        return 0;
+    }
+
+    fputs( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", chromeFile );
+    chromeName( "process_name", CHROME_PID_CPU, 0, "CPU", -1 );
+    chromeName( "thread_name", CHROME_PID_CPU, 0, "CPU", 0 );
+    chromeName( "process_name", CHROME_PID_DEVICES, 0, "Devices", -1 );
+    chromeName( "process_name", CHROME_PID_PROCESSES, 0, "Processes", -1 );
+
+    for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+    {
+        for( int channel = 0; ( channel ) < ( data->deviceChannels[device] );
+             channel++ )
+        {
+            chromeName( "thread_name", CHROME_PID_DEVICES,
+                        device * CFG_MAX_CHANNELS + channel,
+                        DEVICE_NAMES[device], channel );
+        }
+    }
+
+    return 1;
+}
+
+void chromeTraceRecord( const struct SimEvent *event, long long now )
+{
+    /**
+     * Desc:
+     *      Add a logged event to the timeline. Does nothing if no timeline
+     *      is being written.
+     *
+     * Args:
+     *      event (const struct SimEvent*): event that was logged
+     *      now (long long): simulated time of the event
+     */
+    struct ChromeProcess *process;
+
+    if( ( chromeFile ) == ( NULL ) )
+    {
+        return;
+    }
+
+    if( ( event->type ) == ( EVENT_ALL_READY ) )
+    {
+        chromeAllReady = now;
+        return;
+    }
+
+    if( ( event->processId ) < ( 0 ) )
+    {
+        return;
+    }
+
+    process = chromeProcess( event->processId );
+
+    switch( event->type )
+    {
+        case EVENT_PROCESS_STATE:
+            chromeStateChange( process, event->processId, (int) event->value,
+                               now );
+            break;
+
+        case EVENT_OP_START:
+        case EVENT_MMU_START:
+            process->opOpen = 1;
+            process->opStart = now;
+            process->component = event->component;
+            process->opIndex = event->opIndex;
+            break;
+
+        case EVENT_OP_END:
+        case EVENT_MMU_RESULT:
+            chromeOpSlice( process, event->processId, now );
+            process->opOpen = 0;
+            break;
+
+        case EVENT_PREEMPTED:
+            chromeOpSlice( process, event->processId, now );
+            break;
+    }
+}
+
+void chromeTraceDevice( const struct DeviceRequest *request )
+{
+    /**
+     * Desc:
+     *      Add a finished device request to the track of its channel.
+     *
+     * Args:
+     *      request (const struct DeviceRequest*): request that finished
+     */
+    if( ( chromeFile ) == ( NULL ) )
+    {
+        return;
+    }
+
+    chromeSlice( CHROME_PID_DEVICES,
+                 request->device * CFG_MAX_CHANNELS + request->channel,
+                 request->swap ? "Swap" : "Process", request->process,
+                 request->finish - request->service, request->finish );
+}
+
+void chromeTraceClose( void )
+{
+    /**
+     * Desc:
+     *      Finish the JSON document and close the timeline.
+     */
+    if( ( chromeFile ) == ( NULL ) )
+    {
+        return;
+    }
+
+    fputs( "\n]}\n", chromeFile );
+    fclose( chromeFile );
+    chromeFile = NULL;
+    free( chromeProcesses );
+    chromeProcesses = NULL;
+    chromeProcessCapacity = 0;
+}
+
+// End include guard
+#endif              // CHROMETRACE_C
@@ -0,0 +1,41 @@
+/**
+ * Name:
+ *      ChromeTrace.h
+ *
+ * Desc:
+ *      Timeline export in the Chrome Trace Event JSON format, which opens
+ *      in chrome://tracing and the Perfetto UI. The CPU, every device
+ *      channel and every process get their own track.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef CHROMETRACE_H
+#define CHROMETRACE_H
+
+// Trace process ids, one per group of tracks
+//      CPU: one thread, the running process with its P and M ops nested
+//      Devices: one thread per channel, tid device * CFG_MAX_CHANNELS + channel
+//      Processes: one thread per process, tid processId, every op and the
+//                 time spent ready
+#define CHROME_PID_CPU        1
+#define CHROME_PID_DEVICES    2
+#define CHROME_PID_PROCESSES  3
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+#include "SimEvent.h"
+#include "Device.h"
+
+// Function headers
+int chromeTraceOpen( char *tracePath, CfgData *data );
+void chromeTraceRecord( const struct SimEvent *event, long long now );
+void chromeTraceDevice( const struct DeviceRequest *request );
+void chromeTraceClose( void );
+
+// End include guard
+#endif              // CHROMETRACE_H
@@ -0,0 +1,144 @@
+/**
+ * Name:
+ *      Coalesce.c
+ *
+ * Desc:
+ *      Implementation of Coalesce.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Fused P ops still run in slices that end at every file op boundary,
+ *      where the scheduler can't preempt, so a fused run takes the same
+ *      simulated time as the separate ops. I/O ops are only fused for
+ *      non-preemptive policies. There the process holds the CPU and the
+ *      device for the whole run, so one request takes as long as the
+ *      separate ones. Under a preemptive policy the process would go back
+ *      through Ready between them.
+ */
+
+// Include guard
+#ifndef COALESCE_C
+#define COALESCE_C
+
+// Include header
+#include "Coalesce.h"
+
+// Whether fused ops log every file op
+static int verboseOps = 0;
+
+static int canFuse( const struct MetaOp *last, const struct MetaOp *op,
+                    int fuseIo )
+{
+    /**
+     * Desc:
+     *      Whether an op can be fused into the op before it.
+     *
+     * Args:
+     *      last (const struct MetaOp*): op before, possibly already fused
+     *      op (const struct MetaOp*): op that follows it in the file
+     *      fuseIo (int): 1 to fuse I/O ops on the same device
+     *
+     * Returns:
+     *      1 if the ops can be fused, otherwise 0.
+     */
+    if( ( last->component ) != ( op->component ) ||
+        ( last->opCode ) != ( op->opCode ) )
+    {
+        return 0;
+    }
+
+    if( ( op->component ) == ( 'P' ) )
+    {
+        return 1;
+    }
+
+    return fuseIo && ( ( op->component ) == ( 'I' ) ||
+                       ( op->component ) == ( 'O' ) );
+}
+
+// Begin implementation
+void coalesceMetaData( struct MetaData *meta, int fuseIo )
+{
+    /**
+     * Desc:
+     *      Fuse the adjacent ops of every process, keeping the file ops in
+     *      sourceOps.
+     *
+     * Args:
+     *      meta (struct MetaData*): parsed meta data, not coalesced yet
+     *      fuseIo (int): 1 to fuse I/O ops too, for non-preemptive policies
+     */
+    int *newIndex = malloc( sizeof( int ) * ( meta->opCount + 1 ) );
+    int write = 0;
+
+    meta->sourceOps = malloc( sizeof( struct MetaOp ) * ( meta->opCount + 1 ) );
+    memcpy( meta->sourceOps, meta->ops,
+            sizeof( struct MetaOp ) * ( meta->opCount + 1 ) );
+
+    for( int read = 0; ( read ) < ( meta->opCount ); read++ )
+    {
+        const struct MetaOp *op = &meta->sourceOps[read];
+
+        // A and S ops never fuse, so runs can't cross a process boundary
+        if( ( write ) > ( 0 ) && canFuse( &meta->ops[write - 1], op, fuseIo ) )
+        {
+            meta->ops[write - 1].count++;
+            meta->ops[write - 1].cycles += op->cycles;
+            newIndex[read] = write - 1;
+            continue;
+        }
+
+        meta->ops[write] = *op;
+        meta->ops[write].count = 1;
+        meta->ops[write].source = read;
+        newIndex[read] = write;
+        write++;
+    }
+
+    // Move the terminating A(end)
+    newIndex[meta->opCount] = write;
+    meta->ops[write] = meta->sourceOps[meta->opCount];
+    meta->ops[write].source = meta->opCount;
+
+    for( int process = 0; ( process ) < ( meta->programCount ); process++ )
+    {
+        struct ProcessIndex *index = &meta->processes[process];
+        int end = newIndex[index->offset + index->opCount + 1];
+
+        index->offset = newIndex[index->offset];
+        index->opCount = end - index->offset - 1;
+        index->sourceOps = meta->sourceOps;
+    }
+
+    meta->opCount = write;
+    free( newIndex );
+}
+
+void coalesceSetVerbose( int verbose )
+{
+    /**
+     * Desc:
+     *      Choose whether fused ops log every file op they were made of.
+     *
+     * Args:
+     *      verbose (int): 1 to log the file ops
+     */
+    verboseOps = verbose;
+}
+
+int coalesceVerbose( void )
+{
+    /**
+     * Desc:
+     *      Whether fused ops log every file op.
+     *
+     * Returns:
+     *      1 if they do, otherwise 0.
+     */
+    return verboseOps;
+}
+
+// End include guard
+#endif              // COALESCE_C
@@ -0,0 +1,30 @@
+/**
+ * Name:
+ *      Coalesce.h
+ *
+ * Desc:
+ *      Op coalescing. A compile step after parsing fuses runs of adjacent
+ *      P(run) ops, and of adjacent I/O ops on the same device, into single
+ *      ops so they cost one event each. The run is timed as if the ops
+ *      were separate, and verbose output logs every file op again.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef COALESCE_H
+#define COALESCE_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// Function headers
+void coalesceMetaData( struct MetaData *meta, int fuseIo );
+void coalesceSetVerbose( int verbose );
+int coalesceVerbose( void );
+
+// End include guard
+#endif              // COALESCE_H
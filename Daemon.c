@@ -0,0 +1,530 @@
+/**
+ * Name:
+ *      Daemon.c
+ *
+ * Desc:
+ *      Implementation of Daemon.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Clients are served one at a time, each in a fresh simulation that
+ *      starts at time 0. Live processes sit in a fixed set of PCB slots,
+ *      which are reused once a process exits, so memory is bounded by the
+ *      live processes and the jobs the client has sent but that haven't
+ *      arrived yet. Jobs are admitted between dispatches, in arrival
+ *      order, once their arrival time has passed and a slot is free. The
+ *      log always goes to the client in the monitor format, a log file
+ *      would keep growing for as long as the daemon runs.
+ */
+
+// Include guard
+#ifndef DAEMON_C
+#define DAEMON_C
+
+// Include header
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "Daemon.h"
+#include "ProcessPcb.h"
+
+// Programs sent on one line, freed once the last of them exits
+struct DaemonBatch
+{
+    struct MetaData *meta;
+    int live;
+};
+
+// Job that was sent but hasn't been admitted yet, arrival is in usec
+struct DaemonJob
+{
+    long long arrival;
+    struct DaemonBatch *batch;
+    int program;
+};
+
+// State of one client session
+//      jobs is a ring buffer of jobCount jobs starting at jobHead, in
+//      arrival order. input holds what was read past the last full line.
+struct DaemonSession
+{
+    struct SimContext context;
+    FILE *events;
+    int client;
+    int clientOpen;
+    int stopDaemon;
+    struct DaemonBatch **slotBatches;
+    int *freeSlots;
+    int freeCount;
+    struct DaemonJob *jobs;
+    int jobHead;
+    int jobCount;
+    int jobCapacity;
+    long long lastArrival;
+    int nextProcessId;
+    char *input;
+    size_t inputLength;
+    size_t inputCapacity;
+};
+
+static int openSocket( char *socketPath )
+{
+    /**
+     * Desc:
+     *      Create the listening socket, replacing a stale socket file.
+     *
+     * Args:
+     *      socketPath (char*): path of the socket
+     *
+     * Returns:
+     *      The socket, or -1 if it could not be created.
+     */
+    struct sockaddr_un address;
+    int listener = socket( AF_UNIX, SOCK_STREAM, 0 );
+
+    if( ( listener ) < ( 0 ) )
+    {
+        return -1;
+    }
+
+    memset( &address, 0, sizeof( address ) );
+    address.sun_family = AF_UNIX;
+
+    if( ( strlen( socketPath ) ) >= ( sizeof( address.sun_path ) ) )
+    {
+        close( listener );
+        return -1;
+    }
+
+    strcpy( address.sun_path, socketPath );
+    unlink( socketPath );
+
+    if( ( bind( listener, (struct sockaddr *) &address, sizeof( address ) ) )
+        != ( 0 ) || ( listen( listener, 1 ) ) != ( 0 ) )
+    {
+        close( listener );
+        return -1;
+    }
+
+    return listener;
+}
+
+static void queueJob( struct DaemonSession *session, long long arrival,
+                      struct DaemonBatch *batch, int program )
+{
+    /**
+     * Desc:
+     *      Add a job to the back of the arrival queue.
+     *
+     * Args:
+     *      session (struct DaemonSession*): session state
+     *      arrival (long long): simulated arrival time in usec
+     *      batch (struct DaemonBatch*): programs the job comes from
+     *      program (int): index of the job's program in the batch
+     */
+    if( ( session->jobCount ) == ( session->jobCapacity ) )
+    {
+        int capacity = session->jobCapacity * 2;
+        struct DaemonJob *grown = malloc( sizeof( struct DaemonJob ) *
+                                          capacity );
+
+        for( int index = 0; ( index ) < ( session->jobCount ); index++ )
+        {
+            grown[index] = session->jobs[( session->jobHead + index ) %
+                                         session->jobCapacity];
+        }
+
+        free( session->jobs );
+        session->jobs = grown;
+        session->jobHead = 0;
+        session->jobCapacity = capacity;
+    }
+
+    struct DaemonJob *job = &session->jobs[( session->jobHead +
+                                             session->jobCount ) %
+                                           session->jobCapacity];
+
+    job->arrival = arrival;
+    job->batch = batch;
+    job->program = program;
+    session->jobCount++;
+}
+
+static void parseJobLine( struct DaemonSession *session, char *line )
+{
+    /**
+     * Desc:
+     *      Turn one line from the client into jobs, or end the session.
+     *
+     * Args:
+     *      session (struct DaemonSession*): session state
+     *      line (char*): line without its newline
+     */
+    char *ops;
+    long long arrival;
+    struct MetaData *meta;
+
+    while( ( *line ) == ( ' ' ) || ( *line ) == ( '\t' ) || ( *line ) == ( '\r' ) )
+    {
+        line++;
+    }
+
+    if( ( *line ) == ( '\0' ) )
+    {
+        return;
+    }
+
+    if( ( strncmp( line, "S(end)", 6 ) ) == ( 0 ) )
+    {
+        session->clientOpen = 0;
+        session->stopDaemon = 1;
+        return;
+    }
+
+    arrival = strtoll( line, &ops, 10 ) * 1000;
+    meta = ops == line ? NULL : parseMetaText( ops, strlen( ops ) );
+
+    if( ( meta ) == ( NULL ) || ( meta->processCount ) == ( 0 ) )
+    {
+        fprintf( session->events, "Error: illegal job: %s\n", line );
+        fflush( session->events );
+        freeMetaData( meta );
+        return;
+    }
+
+    // Jobs arrive in the order they were sent
+    if( ( arrival ) < ( session->lastArrival ) )
+    {
+        arrival = session->lastArrival;
+    }
+
+    session->lastArrival = arrival;
+
+    struct DaemonBatch *batch = malloc( sizeof( struct DaemonBatch ) );
+    struct ProgramCursor cursor = { 0 };
+    batch->meta = meta;
+    batch->live = meta->processCount;
+
+    for( int program = nextProgram( meta, &cursor ); ( program ) >= ( 0 );
+         program = nextProgram( meta, &cursor ) )
+    {
+        queueJob( session, arrival, batch, program );
+    }
+}
+
+static void readClient( struct DaemonSession *session, int wait )
+{
+    /**
+     * Desc:
+     *      Read whatever the client has sent and parse every full line.
+     *
+     * Args:
+     *      session (struct DaemonSession*): session state
+     *      wait (int): 1 to block until the client sends something
+     */
+    struct pollfd poller = { session->client, POLLIN, 0 };
+    size_t lineStart = 0;
+    ssize_t count;
+
+    if( ( session->clientOpen ) == ( 0 ) ||
+        ( poll( &poller, 1, wait ? -1 : 0 ) ) <= ( 0 ) )
+    {
+        return;
+    }
+
+    if( ( session->inputLength + DAEMON_READ_SIZE + 1 ) >
+        ( session->inputCapacity ) )
+    {
+        session->inputCapacity = ( session->inputLength + DAEMON_READ_SIZE + 1 )
+                                 * 2;
+        session->input = realloc( session->input, session->inputCapacity );
+    }
+
+    count = read( session->client, session->input + session->inputLength,
+                  DAEMON_READ_SIZE );
+
+    if( ( count ) <= ( 0 ) )
+    {
+        if( ( count ) == ( 0 ) || ( errno ) != ( EINTR ) )
+        {
+            session->clientOpen = 0;
+        }
+
+        return;
+    }
+
+    session->inputLength += count;
+
+    for( size_t index = 0; ( index ) < ( session->inputLength ) &&
+                           ( session->clientOpen ) == ( 1 ); index++ )
+    {
+        if( ( session->input[index] ) == ( '\n' ) )
+        {
+            session->input[index] = '\0';
+            parseJobLine( session, session->input + lineStart );
+            lineStart = index + 1;
+        }
+    }
+
+    // Keep the partial line for the next read
+    memmove( session->input, session->input + lineStart,
+             session->inputLength - lineStart );
+    session->inputLength -= lineStart;
+}
+
+static void admitJobs( struct DaemonSession *session )
+{
+    /**
+     * Desc:
+     *      Give every job that has arrived a free slot and make it Ready.
+     *
+     * Args:
+     *      session (struct DaemonSession*): session state
+     */
+    struct SimContext *context = &session->context;
+
+    while( ( session->freeCount ) > ( 0 ) && ( session->jobCount ) > ( 0 ) &&
+           ( session->jobs[session->jobHead].arrival ) <= ( simulatedTime() ) )
+    {
+        struct DaemonJob job = session->jobs[session->jobHead];
+        int slot = session->freeSlots[--session->freeCount];
+        struct pcb *process = &context->pcbArray[slot];
+
+        session->jobHead = ( session->jobHead + 1 ) % session->jobCapacity;
+        session->jobCount--;
+        session->slotBatches[slot] = job.batch;
+
+        initPcb( process, job.batch->meta, job.program,
+            session->nextProcessId++, context->data );
+        processStateAdd( process );
+        logStateChange( process, STATE_READY, context->data, context->logFile,
+            context->logLine, context->timeBuffer );
+        context->scheduler->enqueue( context->schedulerState, slot );
+    }
+}
+
+static void releaseSlot( struct DaemonSession *session, int slot )
+{
+    /**
+     * Desc:
+     *      Free the slot of a process that exited, and its programs once
+     *      nothing else uses them.
+     *
+     * Args:
+     *      session (struct DaemonSession*): session state
+     *      slot (int): slot of the process
+     */
+    struct DaemonBatch *batch = session->slotBatches[slot];
+
+    processStateRemove( &session->context.pcbArray[slot] );
+    releasePcb( &session->context.pcbArray[slot] );
+    batch->live--;
+    if( ( batch->live ) == ( 0 ) )
+    {
+        freeMetaData( batch->meta );
+        free( batch );
+    }
+
+    session->slotBatches[slot] = NULL;
+    session->freeSlots[session->freeCount++] = slot;
+}
+
+static int serveClient( CfgData *data, int client, int slotCount )
+{
+    /**
+     * Desc:
+     *      Run one session, until the client is done and every job it sent
+     *      has exited.
+     *
+     * Args:
+     *      data (CfgData*): config of the simulation
+     *      client (int): connected client socket
+     *      slotCount (int): most processes live at once
+     *
+     * Returns:
+     *      1 if the client asked the daemon to stop, otherwise 0.
+     */
+    struct DaemonSession session;
+    struct SimContext *context = &session.context;
+    const struct SchedulerOps *scheduler = schedulerFor( data->cpuSchedulingCode );
+    struct SimEvent event = { EVENT_SYSTEM_START, -1, 0, -1, 0, 0, NULL };
+
+    memset( &session, 0, sizeof( session ) );
+    session.events = fdopen( dup( client ), "w" );
+    session.client = client;
+    session.clientOpen = 1;
+    session.slotBatches = calloc( slotCount, sizeof( struct DaemonBatch * ) );
+    session.freeSlots = malloc( sizeof( int ) * slotCount );
+    session.jobCapacity = 64;
+    session.jobs = malloc( sizeof( struct DaemonJob ) * session.jobCapacity );
+
+    // Hand out the low slots first
+    for( int slot = 0; ( slot ) < ( slotCount ); slot++ )
+    {
+        session.freeSlots[slot] = slotCount - 1 - slot;
+    }
+
+    session.freeCount = slotCount;
+
+    context->pcbArray = calloc( slotCount, sizeof( struct pcb ) );
+    context->arraySize = slotCount;
+    context->data = data;
+    context->logFile = logFileCreate();
+    context->logLine = malloc( BUFFER_SIZE );
+    context->timeBuffer = malloc( BUFFER_SIZE );
+    context->scheduler = scheduler;
+    context->schedulerState = scheduler->create( data, context->pcbArray,
+                                                 slotCount );
+
+    processStatesStart( context->pcbArray );
+    logSinkSetMonitor( session.events );
+    logSinkStart( data, context->logFile );
+    accessTimer( ZERO_TIMER, context->timeBuffer );
+    accessTimer( LAP_TIMER, context->timeBuffer );
+    logEvent( &event, data, context->logFile, context->logLine,
+        context->timeBuffer );
+    devicesStart( data );
+    cacheStart( data );
+    swapStart( data, slotCount );
+    dispatchCostStart( data );
+
+    while( 1 )
+    {
+        readClient( &session, 0 );
+        admitJobs( &session );
+
+        PROFILE_ENTER( PROFILE_SCHED_DECISION );
+        int slot = scheduler->pickNext( context->schedulerState );
+        PROFILE_LEAVE( PROFILE_SCHED_DECISION );
+
+        if( ( slot ) >= ( 0 ) )
+        {
+            if( ( dispatchProcess( context, slot ) ) == ( 1 ) )
+            {
+                releaseSlot( &session, slot );
+            }
+
+            fflush( session.events );
+            continue;
+        }
+
+        // Nothing is ready, skip ahead to the next device or arrival
+        long long target = devicesNextCompletion();
+
+        if( ( session.freeCount ) > ( 0 ) && ( session.jobCount ) > ( 0 ) &&
+            ( session.jobs[session.jobHead].arrival ) < ( target ) )
+        {
+            target = session.jobs[session.jobHead].arrival;
+        }
+
+        if( ( target ) != ( DEVICE_IDLE ) )
+        {
+            runUntil( context, target );
+            continue;
+        }
+
+        if( ( session.clientOpen ) == ( 0 ) )
+        {
+            break;
+        }
+
+        fflush( session.events );
+        readClient( &session, 1 );
+    }
+
+    event.type = EVENT_SYSTEM_STOP;
+    logEvent( &event, data, context->logFile, context->logLine,
+        context->timeBuffer );
+    fflush( session.events );
+    logSinkSetMonitor( NULL );
+
+    scheduler->destroy( context->schedulerState );
+    devicesFree();
+    cacheFree();
+    swapFree();
+
+    // Jobs that never arrived, a batch is freed with its last job
+    while( ( session.jobCount ) > ( 0 ) )
+    {
+        struct DaemonBatch *batch = session.jobs[session.jobHead].batch;
+
+        session.jobHead = ( session.jobHead + 1 ) % session.jobCapacity;
+        session.jobCount--;
+
+        if( ( --batch->live ) == ( 0 ) )
+        {
+            freeMetaData( batch->meta );
+            free( batch );
+        }
+    }
+
+    fclose( session.events );
+    deallocateLogFile( context->logFile );
+    deallocateBuffers( context->timeBuffer, context->logLine );
+    deallocatePcb( context->pcbArray, slotCount );
+    free( session.slotBatches );
+    free( session.freeSlots );
+    free( session.jobs );
+    free( session.input );
+    return session.stopDaemon;
+}
+
+// Begin implementation
+int runDaemon( CfgData *data, char *socketPath )
+{
+    /**
+     * Desc:
+     *      Serve clients on a Unix domain socket until one sends S(end).
+     *
+     * Args:
+     *      data (CfgData*): config of the simulation
+     *      socketPath (char*): path of the socket to listen on
+     *
+     * Returns:
+     *      0 once a client stopped the daemon, -1 if the socket could not
+     *      be opened.
+     */
+    int listener = openSocket( socketPath );
+    int slotCount = data->multiprogrammingLimit > 0 ?
+                    data->multiprogrammingLimit : DAEMON_DEFAULT_SLOTS;
+    int stop = 0;
+
+    if( ( listener ) < ( 0 ) )
+    {
+        return -1;
+    }
+
+    // A client that hangs up early must not kill the daemon
+    signal( SIGPIPE, SIG_IGN );
+    data->logTo = LOG_MONITOR;
+
+    while( ( stop ) == ( 0 ) )
+    {
+        int client = accept( listener, NULL, NULL );
+
+        if( ( client ) < ( 0 ) )
+        {
+            if( ( errno ) == ( EINTR ) )
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        stop = serveClient( data, client, slotCount );
+        close( client );
+    }
+
+    close( listener );
+    unlink( socketPath );
+    return stop ? 0 : -1;
+}
+
+// End include guard
+#endif              // DAEMON_C
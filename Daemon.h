@@ -0,0 +1,42 @@
+/**
+ * Name:
+ *      Daemon.h
+ *
+ * Desc:
+ *      Job submission daemon. Listens on a Unix domain socket, simulates
+ *      the programs clients send as they arrive, and streams the log back
+ *      to the client.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Protocol, one job per line:
+ *          <arrival msec> A(start)0; P(run)5; I(keyboard)3; A(end)0.
+ *      Arrival is in simulated msec since the client connected, a job that
+ *      arrives earlier than the one before it arrives with it. A line may
+ *      hold several programs, they all arrive together. "S(end)" ends the
+ *      session and stops the daemon, closing the connection only ends the
+ *      session.
+ */
+
+// Include guard
+#ifndef DAEMON_H
+#define DAEMON_H
+
+// Live processes when no multiprogramming limit is configured
+#define DAEMON_DEFAULT_SLOTS  1024
+
+// Bytes read from the client at a time
+#define DAEMON_READ_SIZE      4096
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// Function headers
+int runDaemon( CfgData *data, char *socketPath );
+
+// End include guard
+#endif              // DAEMON_H
@@ -0,0 +1,470 @@
+/**
+ * Name:
+ *      Device.c
+ *
+ * Desc:
+ *      Implementation of Device.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      There is one set of devices per run, kept in this file the same way
+ *      simtimer keeps its timer state. Callers pass the simulated time of
+ *      every change so the statistics can be integrated over time.
+ */
+
+// Include guard
+#ifndef DEVICE_C
+#define DEVICE_C
+
+// Include header
+#include "Device.h"
+
+// Device state, one per DEVICE_CLASSES
+static struct Device devices[DEVICE_COUNT];
+static int devicesStarted = 0;
+
+static void accountDevice( struct Device *device, long long now )
+{
+    /**
+     * Desc:
+     *      Add the time since the last change to the busy and queue length
+     *      integrals of a device.
+     *
+     * Args:
+     *      device (struct Device*): device to update
+     *      now (long long): current simulated time
+     */
+    long long elapsed = now - device->lastChange;
+
+    device->busyArea += elapsed * device->busyCount;
+    device->queueArea += elapsed * device->queueLength;
+    device->lastChange = now;
+}
+
+static void startRequest( struct Device *device, struct DeviceRequest request,
+                          long long now )
+{
+    /**
+     * Desc:
+     *      Put a request on the lowest free channel of a device.
+     *
+     * Args:
+     *      device (struct Device*): device with at least one free channel
+     *      request (struct DeviceRequest): request to start
+     *      now (long long): current simulated time
+     */
+    int channel = 0;
+
+    while( ( device->channels[channel].process ) >= ( 0 ) )
+    {
+        channel++;
+    }
+
+    request.channel = channel;
+    request.finish = now + request.service;
+    device->channels[channel] = request;
+    device->busyCount++;
+}
+
+// Begin implementation
+int deviceClass( int opCode )
+{
+    /**
+     * Desc:
+     *      Map an I/O op code to the device class that serves it.
+     *
+     * Args:
+     *      opCode (int): META_OP_CODES value of an I or O op
+     *
+     * Returns:
+     *      The DEVICE_CLASSES value, or -1 if the op is not a device op.
+     */
+    switch( opCode )
+    {
+        case OP_HARD_DRIVE:
+            return DEVICE_HARD_DRIVE;
+
+        case OP_KEYBOARD:
+            return DEVICE_KEYBOARD;
+
+        case OP_PRINTER:
+            return DEVICE_PRINTER;
+
+        case OP_MONITOR:
+            return DEVICE_MONITOR;
+    }
+
+    return -1;
+}
+
+int deviceCycleTime( CfgData *data, int opCode )
+{
+    /**
+     * Desc:
+     *      Cycle time of the device serving an I/O op.
+     *
+     * Args:
+     *      data (CfgData*): config holding the cycle times
+     *      opCode (int): META_OP_CODES value of an I or O op
+     *
+     * Returns:
+     *      The device's own cycle time if one was configured, otherwise
+     *      the I/O cycle time.
+     */
+    return deviceClassCycleTime( data, deviceClass( opCode ) );
+}
+
+int deviceClassCycleTime( CfgData *data, int device )
+{
+    /**
+     * Desc:
+     *      Cycle time of a device class.
+     *
+     * Args:
+     *      data (CfgData*): config holding the cycle times
+     *      device (int): DEVICE_CLASSES value, or -1 for no device
+     *
+     * Returns:
+     *      The device's own cycle time if one was configured, otherwise
+     *      the I/O cycle time.
+     */
+    if( ( device ) >= ( 0 ) && ( data->deviceCycleTime[device] ) > ( 0 ) )
+    {
+        return data->deviceCycleTime[device];
+    }
+
+    return data->ioCycleTime;
+}
+
+long long deviceIoTime( CfgData *data, long long ioCycles,
+                        const long long *deviceCycles )
+{
+    /**
+     * Desc:
+     *      Time a burst of I/O cycles takes, each device's cycles at that
+     *      device's cycle time and the rest at the I/O cycle time.
+     *
+     * Args:
+     *      data (CfgData*): config holding the cycle times
+     *      ioCycles (long long): I/O cycles of the burst
+     *      deviceCycles (const long long*): ioCycles split by
+     *                                       DEVICE_CLASSES, or NULL
+     *
+     * Returns:
+     *      The time in msec.
+     */
+    long long time = 0;
+    long long deviceIo = 0;
+
+    for( int device = 0; ( device ) < ( DEVICE_COUNT ) &&
+         ( deviceCycles ) != ( NULL ); device++ )
+    {
+        time += deviceCycles[device] * deviceClassCycleTime( data, device );
+        deviceIo += deviceCycles[device];
+    }
+
+    return time + ( ioCycles - deviceIo ) * data->ioCycleTime;
+}
+
+void devicesStart( CfgData *data )
+{
+    /**
+     * Desc:
+     *      Set up idle devices with the channel counts from the config,
+     *      dropping any previous devices and statistics.
+     *
+     * Args:
+     *      data (CfgData*): config holding the channel counts
+     */
+    devicesFree();
+
+    for( int index = 0; ( index ) < ( DEVICE_COUNT ); index++ )
+    {
+        struct Device *device = &devices[index];
+
+        device->channelCount = data->deviceChannels[index];
+        device->busyCount = 0;
+        device->channels = malloc( sizeof( struct DeviceRequest ) *
+                                   device->channelCount );
+        for( int channel = 0; ( channel ) < ( device->channelCount );
+             channel++ )
+        {
+            device->channels[channel].process = -1;
+        }
+        device->queueCapacity = 16;
+        device->queue = malloc( sizeof( struct DeviceRequest ) *
+                                device->queueCapacity );
+        device->queueHead = 0;
+        device->queueLength = 0;
+        device->lastChange = 0;
+        device->busyArea = 0;
+        device->queueArea = 0;
+        device->maxQueueLength = 0;
+        device->requestCount = 0;
+        device->completedCount = 0;
+        device->totalDelay = 0;
+        device->maxDelay = 0;
+    }
+
+    devicesStarted = 1;
+}
+
+void deviceSubmit( int device, int process, int swap, long long service,
+                   long long now )
+{
+    /**
+     * Desc:
+     *      Hand a request to a device. It starts at once if a channel is
+     *      free, otherwise it waits at the back of the device queue.
+     *
+     * Args:
+     *      device (int): DEVICE_CLASSES value of the device
+     *      process (int): index of the requesting process
+     *      swap (int): 1 for a swap transfer, 0 for an I/O op
+     *      service (long long): simulated time the request takes, a
+     *                           negative time is served at once
+     *      now (long long): current simulated time
+     */
+    struct Device *target = &devices[device];
+    struct DeviceRequest request = { process, device, -1, swap, now,
+                                      service > 0 ? service : 0, 0 };
+
+    accountDevice( target, now );
+    target->requestCount++;
+
+    if( ( target->busyCount ) < ( target->channelCount ) )
+    {
+        startRequest( target, request, now );
+        return;
+    }
+
+    if( ( target->queueLength ) == ( target->queueCapacity ) )
+    {
+        struct DeviceRequest *grown = malloc( sizeof( struct DeviceRequest ) *
+                                              target->queueCapacity * 2 );
+
+        for( int index = 0; ( index ) < ( target->queueLength ); index++ )
+        {
+            grown[index] = target->queue[( target->queueHead + index ) %
+                                         target->queueCapacity];
+        }
+
+        free( target->queue );
+        target->queue = grown;
+        target->queueHead = 0;
+        target->queueCapacity *= 2;
+    }
+
+    target->queue[( target->queueHead + target->queueLength ) %
+                  target->queueCapacity] = request;
+    target->queueLength++;
+
+    if( ( target->queueLength ) > ( target->maxQueueLength ) )
+    {
+        target->maxQueueLength = target->queueLength;
+    }
+}
+
+long long devicesNextCompletion( void )
+{
+    /**
+     * Desc:
+     *      Find when the next request on any device finishes.
+     *
+     * Returns:
+     *      The simulated finish time, or DEVICE_IDLE if every device is
+     *      idle.
+     */
+    long long next = DEVICE_IDLE;
+
+    for( int index = 0; ( index ) < ( DEVICE_COUNT ); index++ )
+    {
+        struct Device *device = &devices[index];
+
+        for( int channel = 0; ( channel ) < ( device->channelCount ); channel++ )
+        {
+            if( ( device->channels[channel].process ) < ( 0 ) )
+            {
+                continue;
+            }
+
+            if( ( device->channels[channel].finish ) < ( next ) )
+            {
+                next = device->channels[channel].finish;
+            }
+        }
+    }
+
+    return next;
+}
+
+int devicesComplete( long long now, struct DeviceRequest *finished )
+{
+    /**
+     * Desc:
+     *      Finish the earliest request that is done by now and start the
+     *      next queued request on its channel. Requests finishing at the
+     *      same time complete in device class order.
+     *
+     * Args:
+     *      now (long long): current simulated time
+     *      finished (struct DeviceRequest*): receives the finished request,
+     *                                        may be NULL
+     *
+     * Returns:
+     *      The process index of the finished request, or -1 if no request
+     *      is done yet.
+     */
+    struct Device *done = NULL;
+    int doneChannel = 0;
+    int process;
+
+    for( int index = 0; ( index ) < ( DEVICE_COUNT ); index++ )
+    {
+        struct Device *device = &devices[index];
+
+        for( int channel = 0; ( channel ) < ( device->channelCount ); channel++ )
+        {
+            long long finish = device->channels[channel].finish;
+
+            if( ( device->channels[channel].process ) >= ( 0 ) &&
+                ( finish ) <= ( now ) && ( ( done ) == ( NULL ) ||
+                ( finish ) < ( done->channels[doneChannel].finish ) ) )
+            {
+                done = device;
+                doneChannel = channel;
+            }
+        }
+    }
+
+    if( ( done ) == ( NULL ) )
+    {
+        return -1;
+    }
+
+    accountDevice( done, now );
+    process = done->channels[doneChannel].process;
+
+    // Delays are counted once a request is done, the time it queued
+    long long delay = done->channels[doneChannel].finish -
+                      done->channels[doneChannel].service -
+                      done->channels[doneChannel].arrival;
+
+    done->completedCount++;
+    done->totalDelay += delay;
+    if( ( delay ) > ( done->maxDelay ) )
+    {
+        done->maxDelay = delay;
+    }
+
+    if( ( finished ) != ( NULL ) )
+    {
+        *finished = done->channels[doneChannel];
+    }
+
+    done->busyCount--;
+    done->channels[doneChannel].process = -1;
+
+    if( ( done->queueLength ) > ( 0 ) )
+    {
+        struct DeviceRequest next = done->queue[done->queueHead];
+
+        done->queueHead = ( done->queueHead + 1 ) % done->queueCapacity;
+        done->queueLength--;
+        startRequest( done, next, now );
+    }
+
+    return process;
+}
+
+int deviceBusyChannels( int device )
+{
+    /**
+     * Desc:
+     *      Number of channels of a device serving a request right now.
+     *
+     * Args:
+     *      device (int): DEVICE_CLASSES value of the device
+     *
+     * Returns:
+     *      The busy channel count, 0 before the devices are started.
+     */
+    if( ( devicesStarted ) == ( 0 ) )
+    {
+        return 0;
+    }
+
+    return devices[device].busyCount;
+}
+
+void devicesPrintStats( long long now )
+{
+    /**
+     * Desc:
+     *      Print the statistics of every device that served a request.
+     *
+     * Args:
+     *      now (long long): simulated time the run ended
+     */
+    printf( "\n___________DEVICE STATS___________\n" );
+    printf( "%-12s %8s %10s %8s %10s %9s %14s %13s\n", "Device", "Channels",
+            "Requests", "Util %", "Mean Queue", "Max Queue", "Mean Delay ms",
+            "Max Delay ms" );
+
+    if( ( devicesStarted ) == ( 0 ) )
+    {
+        return;
+    }
+
+    for( int index = 0; ( index ) < ( DEVICE_COUNT ); index++ )
+    {
+        struct Device *device = &devices[index];
+        double elapsed = (double) now;
+
+        if( ( device->requestCount ) == ( 0 ) )
+        {
+            continue;
+        }
+
+        accountDevice( device, now );
+
+        if( ( elapsed ) <= ( 0.0 ) )
+        {
+            elapsed = 1.0;
+        }
+
+        printf( "%-12s %8d %10lld %8.2f %10.3f %9d %14.3f %13.3f\n",
+                DEVICE_NAMES[index], device->channelCount,
+                device->requestCount,
+                100.0 * device->busyArea / ( elapsed * device->channelCount ),
+                device->queueArea / elapsed, device->maxQueueLength,
+                device->completedCount > 0 ? (double) device->totalDelay /
+                    device->completedCount / 1000 : 0.0,
+                (double) device->maxDelay / 1000 );
+    }
+}
+
+void devicesFree( void )
+{
+    /**
+     * Desc:
+     *      Free the device queues and channels.
+     */
+    if( ( devicesStarted ) == ( 0 ) )
+    {
+        return;
+    }
+
+    for( int index = 0; ( index ) < ( DEVICE_COUNT ); index++ )
+    {
+        free( devices[index].channels );
+        free( devices[index].queue );
+    }
+
+    devicesStarted = 0;
+}
+
+// End include guard
+#endif              // DEVICE_C
@@ -0,0 +1,84 @@
+/**
+ * Name:
+ *      Device.h
+ *
+ * Desc:
+ *      I/O device queueing model. Each device class has a FIFO queue in
+ *      front of a configurable number of channels, and keeps utilization,
+ *      queue length and queueing delay statistics in simulated time.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef DEVICE_H
+#define DEVICE_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// devicesNextCompletion when every device is idle. Later than any real
+// finish time, so it never looks due.
+#define DEVICE_IDLE  LLONG_MAX
+
+// Request waiting for, or being served by, a channel
+//      process is the caller's index of the requesting process, -1 in a
+//      free channel. channel is set once the request is served. swap marks
+//      requests that move memory to or from swap space. Times are simulated
+//      microseconds.
+struct DeviceRequest
+{
+    int process;
+    int device;
+    int channel;
+    int swap;
+    long long arrival;
+    long long service;
+    long long finish;
+};
+
+// Device class state
+//      channels has one slot per channel, a request keeps its slot until
+//      it finishes. queue is a ring buffer of queueLength requests starting
+//      at queueHead. Areas are integrals over simulated time, used for the
+//      time weighted means. requestCount counts every submitted request,
+//      the queueing delays only the completedCount finished ones.
+struct Device
+{
+    int channelCount;
+    int busyCount;
+    struct DeviceRequest *channels;
+    struct DeviceRequest *queue;
+    int queueHead;
+    int queueLength;
+    int queueCapacity;
+    long long lastChange;
+    long long busyArea;
+    long long queueArea;
+    int maxQueueLength;
+    long long requestCount;
+    long long completedCount;
+    long long totalDelay;
+    long long maxDelay;
+};
+
+// Function headers
+int deviceClass( int opCode );
+int deviceCycleTime( CfgData *data, int opCode );
+int deviceClassCycleTime( CfgData *data, int device );
+long long deviceIoTime( CfgData *data, long long ioCycles,
+                        const long long *deviceCycles );
+void devicesStart( CfgData *data );
+void deviceSubmit( int device, int process, int swap, long long service,
+                   long long now );
+long long devicesNextCompletion( void );
+int devicesComplete( long long now, struct DeviceRequest *finished );
+int deviceBusyChannels( int device );
+void devicesPrintStats( long long now );
+void devicesFree( void );
+
+// End include guard
+#endif              // DEVICE_H
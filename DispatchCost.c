@@ -0,0 +1,151 @@
+/**
+ * Name:
+ *      DispatchCost.c
+ *
+ * Desc:
+ *      Implementation of DispatchCost.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      There is one set of costs per run, kept in this file the same way
+ *      Device.c keeps its devices. A dispatch always pays the scheduler
+ *      time. Only a dispatch of a different process than the one that ran
+ *      last pays the switch time and the cold cache penalty, a process
+ *      that gets the CPU straight back still has its state loaded. The
+ *      overhead is charged with runUntil, so device interrupts are served
+ *      while the CPU is switching.
+ */
+
+// Include guard
+#ifndef DISPATCHCOST_C
+#define DISPATCHCOST_C
+
+// Include header
+#include "DispatchCost.h"
+#include "ProcessPcb.h"
+
+// Costs in usec
+static int costOn = 0;
+static long long schedulerCost = 0;
+static long long switchCost = 0;
+static long long coldCost = 0;
+static int lastProcess = -1;
+
+// Statistics
+static long long dispatches = 0;
+static long long switches = 0;
+static long long schedulerTotal = 0;
+static long long switchTotal = 0;
+static long long coldTotal = 0;
+static long long cpuTotal = 0;
+
+// Begin implementation
+int dispatchCostEnabled( void )
+{
+    /**
+     * Desc:
+     *      Whether any dispatch overhead is configured.
+     *
+     * Returns:
+     *      1 if dispatches cost time, otherwise 0.
+     */
+    return costOn;
+}
+
+void dispatchCostStart( CfgData *data )
+{
+    /**
+     * Desc:
+     *      Take the costs from the config, dropping any previous statistics.
+     *
+     * Args:
+     *      data (CfgData*): config holding the dispatch overheads
+     */
+    schedulerCost = data->schedulerTime;
+    switchCost = data->switchTime;
+    coldCost = data->coldCachePenalty;
+    costOn = schedulerCost > 0 || switchCost > 0 || coldCost > 0;
+    lastProcess = -1;
+    dispatches = 0;
+    switches = 0;
+    schedulerTotal = 0;
+    switchTotal = 0;
+    coldTotal = 0;
+    cpuTotal = 0;
+}
+
+void dispatchCostCharge( struct SimContext *context, int processIndex )
+{
+    /**
+     * Desc:
+     *      Charge the overhead of putting a process on the CPU.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     *      processIndex (int): index of the process being dispatched
+     */
+    int processId = context->pcbArray[processIndex].processCounter;
+    long long cost = schedulerCost;
+
+    dispatches++;
+    schedulerTotal += schedulerCost;
+
+    // The first dispatch has nothing to switch from
+    if( ( processId ) != ( lastProcess ) && ( lastProcess ) >= ( 0 ) )
+    {
+        switches++;
+        switchTotal += switchCost;
+        coldTotal += coldCost;
+        cost += switchCost + coldCost;
+    }
+
+    lastProcess = processId;
+
+    if( ( cost ) > ( 0 ) )
+    {
+        runUntil( context, simulatedTime() + cost );
+    }
+}
+
+void dispatchCostRecordCpu( long long time )
+{
+    /**
+     * Desc:
+     *      Count simulated time the CPU spent running ops.
+     *
+     * Args:
+     *      time (long long): usec of op time
+     */
+    cpuTotal += time;
+}
+
+void dispatchCostPrintStats( void )
+{
+    /**
+     * Desc:
+     *      Print the overhead by kind and as a share of the CPU busy time,
+     *      which is the op time plus the overhead.
+     */
+    long long overhead = schedulerTotal + switchTotal + coldTotal;
+    double busy = (double) ( cpuTotal + overhead );
+
+    if( ( busy ) <= ( 0.0 ) )
+    {
+        busy = 1.0;
+    }
+
+    printf( "\n___________DISPATCH STATS___________\n" );
+    printf( "Dispatches          : %lld\n", dispatches );
+    printf( "Context Switches    : %lld\n", switches );
+    printf( "Scheduler Time      : %.3f mSec\n", schedulerTotal / 1000.0 );
+    printf( "Switch Time         : %.3f mSec\n", switchTotal / 1000.0 );
+    printf( "Cold Cache Time     : %.3f mSec\n", coldTotal / 1000.0 );
+    printf( "CPU Op Time         : %.3f mSec\n", cpuTotal / 1000.0 );
+    printf( "Overhead            : %.2f %% of CPU busy time\n",
+            100.0 * overhead / busy );
+}
+
+// End include guard
+#endif              // DISPATCHCOST_C
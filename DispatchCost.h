@@ -0,0 +1,34 @@
+/**
+ * Name:
+ *      DispatchCost.h
+ *
+ * Desc:
+ *      Dispatch overhead model. Every scheduling decision, every switch to
+ *      another process and the cold cache after a switch cost simulated
+ *      time, and the overhead is reported against the CPU time of the ops.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef DISPATCHCOST_H
+#define DISPATCHCOST_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// Defined in ProcessPcb.h
+struct SimContext;
+
+// Function headers
+int dispatchCostEnabled( void );
+void dispatchCostStart( CfgData *data );
+void dispatchCostCharge( struct SimContext *context, int processIndex );
+void dispatchCostRecordCpu( long long time );
+void dispatchCostPrintStats( void );
+
+// End include guard
+#endif              // DISPATCHCOST_H
@@ -0,0 +1,287 @@
+/**
+ * Name:
+ *      EventTrace.c
+ *
+ * Desc:
+ *      Implementation of EventTrace.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Only one trace can be recorded at a time, the recorder state is kept
+ *      in this file the same way simtimer keeps its timer state.
+ */
+
+// Include guard
+#ifndef EVENTTRACE_C
+#define EVENTTRACE_C
+
+// Include header
+#include "EventTrace.h"
+#include "ProcessPcb.h"
+
+// Recorder state
+static FILE *traceFile = NULL;
+static int64_t traceEventCount = 0;
+
+// Begin implementation
+int traceOpen( char *tracePath, CfgData *data )
+{
+    /**
+     * Desc:
+     *      Start recording every logged event to a binary trace file.
+     *
+     * Args:
+     *      tracePath (char*): path of the trace file to create
+     *      data (CfgData*): config of the run being recorded
+     *
+     * Returns:
+     *      1 if the trace file was created, otherwise 0.
+     */
+    int64_t header[TRACE_HEADER_INTS] = { TRACE_MAGIC, TRACE_VERSION,
+                                          data->cpuSchedulingCode,
+                                          data->procCycleTime,
+                                          data->ioCycleTime, 0, 0 };
+
+    traceFile = fopen( tracePath, "wb" );
+    traceEventCount = 0;
+
+    if( ( traceFile ) == ( NULL ) )
+    {
+        return 0;
+    }
+
+    fwrite( header, sizeof( int64_t ), TRACE_HEADER_INTS, traceFile );
+    return 1;
+}
+
+void traceRecord( const struct SimEvent *event )
+{
+    /**
+     * Desc:
+     *      Append an event to the open trace. Does nothing if no trace is
+     *      being recorded.
+     *
+     * Args:
+     *      event (const struct SimEvent*): event to record
+     */
+    if( ( traceFile ) == ( NULL ) )
+    {
+        return;
+    }
+
+    int64_t record[TRACE_RECORD_INTS] = { event->type, event->processId,
+                                          event->component, event->opIndex,
+                                          event->value, event->value2 };
+
+    fwrite( record, sizeof( int64_t ), TRACE_RECORD_INTS, traceFile );
+
+    // Selections keep the split of their I/O cycles, to be re-timed
+    if( ( event->type ) == ( EVENT_PROCESS_SELECTED ) )
+    {
+        int64_t deviceCycles[DEVICE_COUNT] = { 0 };
+
+        for( int device = 0; ( device ) < ( DEVICE_COUNT ) &&
+             ( event->deviceCycles ) != ( NULL ); device++ )
+        {
+            deviceCycles[device] = event->deviceCycles[device];
+        }
+
+        fwrite( deviceCycles, sizeof( int64_t ), DEVICE_COUNT, traceFile );
+    }
+
+    traceEventCount++;
+}
+
+void traceClose( void )
+{
+    /**
+     * Desc:
+     *      Write the models the run used and the final event count into the
+     *      header and close the trace. Called before the models are freed.
+     */
+    if( ( traceFile ) == ( NULL ) )
+    {
+        return;
+    }
+
+    int64_t tail[2] = { 0, traceEventCount };
+
+    if( dispatchCostEnabled() )
+    {
+        tail[0] |= TRACE_FEATURE_DISPATCH;
+    }
+    if( cacheEnabled() )
+    {
+        tail[0] |= TRACE_FEATURE_CACHE;
+    }
+    if( swapEnabled() )
+    {
+        tail[0] |= TRACE_FEATURE_SWAP;
+    }
+
+    fseek( traceFile, sizeof( int64_t ) * ( TRACE_HEADER_INTS - 2 ), SEEK_SET );
+    fwrite( tail, sizeof( int64_t ), 2, traceFile );
+    fclose( traceFile );
+    traceFile = NULL;
+}
+
+struct LogFile *replayTrace( char *tracePath, CfgData *data )
+{
+    /**
+     * Desc:
+     *      Re-time a recorded trace with the cycle times in data and rebuild
+     *      the log it would have produced. The scheduler is not run, so this
+     *      is only done for traces recorded under FCFS-N, where the order of
+     *      the processes does not depend on the cycle times. Only ops are
+     *      re-timed, so traces of runs that charged dispatch overhead, cache
+     *      accesses or swap transfers are refused.
+     *
+     * Args:
+     *      tracePath (char*): path of a trace recorded with traceOpen
+     *      data (CfgData*): config holding the new cycle times and log mode
+     *
+     * Returns:
+     *      The rebuilt log, or NULL if the trace can't be replayed.
+     */
+    FILE *trace = fopen( tracePath, "rb" );
+    int64_t header[TRACE_HEADER_INTS];
+    int64_t record[TRACE_RECORD_INTS];
+
+    if( ( trace ) == ( NULL ) )
+    {
+        return NULL;
+    }
+
+    if( ( fread( header, sizeof( int64_t ), TRACE_HEADER_INTS, trace ) )
+        != ( TRACE_HEADER_INTS ) || ( header[0] ) != ( TRACE_MAGIC ) ||
+        ( header[1] ) != ( TRACE_VERSION ) )
+    {
+        fprintf( stderr, "Not a valid trace file: %s\n", tracePath );
+        fclose( trace );
+        return NULL;
+    }
+
+    if( ( header[2] ) != ( 0 ) )
+    {
+        fprintf( stderr, "Trace was recorded under %s, only FCFS-N traces "
+                 "can be re-timed\n", schedulerName( header[2] ) );
+        fclose( trace );
+        return NULL;
+    }
+
+    if( ( header[5] ) != ( 0 ) )
+    {
+        fprintf( stderr, "Trace was recorded with%s%s%s, only op times "
+                 "can be re-timed\n",
+                 ( header[5] & TRACE_FEATURE_DISPATCH ) ? " dispatch cost" : "",
+                 ( header[5] & TRACE_FEATURE_CACHE ) ? " cache" : "",
+                 ( header[5] & TRACE_FEATURE_SWAP ) ? " swap" : "" );
+        fclose( trace );
+        return NULL;
+    }
+
+    char *timeBuffer = (char *)malloc( BUFFER_SIZE );
+    char *logLine = (char *)malloc( BUFFER_SIZE );
+    struct LogFile *logFile = logFileCreate();
+    double *runStart = NULL;
+    double *runTime = NULL;
+    int processCount = 0;
+    int eventCount = 0;
+    long long deviceCycles[DEVICE_COUNT];
+
+    // Decisions come from the trace, times come from the new config
+    data->cpuSchedulingCode = header[2];
+    setTimerMode( VIRTUAL_TIMER );
+    accessTimer( ZERO_TIMER, timeBuffer );
+    logSinkStart( data, logFile );
+
+    while( ( fread( record, sizeof( int64_t ), TRACE_RECORD_INTS, trace ) )
+           == ( TRACE_RECORD_INTS ) )
+    {
+        struct SimEvent event = { record[0], record[1], (char) record[2],
+                                  record[3], record[4], record[5], NULL };
+
+        if( ( event.type ) == ( EVENT_PROCESS_SELECTED ) )
+        {
+            int64_t payload[DEVICE_COUNT];
+
+            if( ( fread( payload, sizeof( int64_t ), DEVICE_COUNT, trace ) )
+                != ( DEVICE_COUNT ) )
+            {
+                break;
+            }
+
+            for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+            {
+                deviceCycles[device] = payload[device];
+            }
+            event.deviceCycles = deviceCycles;
+        }
+
+        // Ops are the only events that take time
+        if( ( event.type ) == ( EVENT_OP_END ) )
+        {
+            if( ( event.component ) == ( 'P' ) )
+            {
+                runTimer( event.value * data->procCycleTime );
+            }
+            else
+            {
+                runTimer( event.value *
+                          deviceCycleTime( data, event.opIndex ) );
+            }
+        }
+
+        // Keep track of how long each process ran for the metrics
+        if( ( event.type ) == ( EVENT_PROCESS_STATE ) )
+        {
+            if( ( event.processId ) >= ( processCount ) )
+            {
+                runStart = realloc( runStart,
+                                    sizeof( double ) * ( event.processId + 1 ) );
+                runTime = realloc( runTime,
+                                   sizeof( double ) * ( event.processId + 1 ) );
+                for( ; ( processCount ) <= ( event.processId ); processCount++ )
+                {
+                    runStart[processCount] = 0.0;
+                    runTime[processCount] = 0.0;
+                }
+            }
+
+            if( ( event.value ) == ( STATE_RUNNING ) )
+            {
+                runStart[event.processId] = accessTimer( LAP_TIMER,
+                                                         timeBuffer );
+            }
+            else if( ( event.value ) == ( STATE_EXIT ) )
+            {
+                runTime[event.processId] = accessTimer( LAP_TIMER, timeBuffer )
+                                           - runStart[event.processId];
+            }
+        }
+
+        logEvent( &event, data, logFile, logLine, timeBuffer );
+        eventCount++;
+    }
+
+    printf( "\n___________REPLAY METRICS___________\n" );
+    printf( "Events Replayed     : %d\n", eventCount );
+    printf( "Simulated Run Time  : %f sec\n",
+            accessTimer( LAP_TIMER, timeBuffer ) );
+    for( int index = 0; ( index ) < ( processCount ); index++ )
+    {
+        printf( "Process %-12d: %f sec\n", index, runTime[index] );
+    }
+
+    free( runStart );
+    free( runTime );
+    deallocateBuffers( timeBuffer, logLine );
+    setTimerMode( REAL_TIMER );
+    fclose( trace );
+    return logFile;
+}
+
+// End include guard
+#endif              // EVENTTRACE_C
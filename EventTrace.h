@@ -0,0 +1,48 @@
+/**
+ * Name:
+ *      EventTrace.h
+ *
+ * Desc:
+ *      Binary event trace recording, and replay of a recorded trace under
+ *      new cycle times without re-running the scheduler.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+// Trace file constants
+//      Header: magic, version, scheduling code, processor cycle time,
+//              I/O cycle time, features, event count
+//      Record: type, processId, component, opIndex, value, value2, then
+//              for EVENT_PROCESS_SELECTED the DEVICE_COUNT deviceCycles
+//      All fields are 64 bit integers in host byte order.
+#define TRACE_MAGIC        0x52543453
+#define TRACE_VERSION      4
+#define TRACE_HEADER_INTS  7
+#define TRACE_RECORD_INTS  6
+
+// Trace feature bits, set for the models that took simulated time in the
+// recorded run. Replay only re-times ops, so it refuses any of these.
+#define TRACE_FEATURE_DISPATCH  0x1
+#define TRACE_FEATURE_CACHE     0x2
+#define TRACE_FEATURE_SWAP      0x4
+
+// Include header
+#include <stdio.h>
+#include <stdint.h>
+#include "InputDataProcessor.h"
+#include "LinkedList.h"
+#include "SimEvent.h"
+
+// Function headers
+int traceOpen( char *tracePath, CfgData *data );
+void traceRecord( const struct SimEvent *event );
+void traceClose( void );
+struct LogFile *replayTrace( char *tracePath, CfgData *data );
+
+// End include guard
+#endif              // EVENTTRACE_H
@@ -13,17 +13,86 @@
 #ifndef INPUTDATAPROCESSOR_C
 #define INPUTDATAPROCESSOR_C
 
+// memmem is a GNU extension
+#define _GNU_SOURCE
+
 // Include header
 #include "InputDataProcessor.h"
+#include "MetaScanner.h"
+#include "LogSink.h"
+#include "Scheduler.h"
+#include "Device.h"
 
 // Constant for input buffer size
 #define BUFFER_SIZE 255
 
+// Thread count for parsing large meta data files, 0 for one per core
+static int metaParseThreads = 0;
+
+static struct MetaData *parseMetaBuffer( char *text, size_t fileSize );
+
+// Program kept in a chunk's ops
+//      hash covers the A(start) and the ops up to the A(end), offset and
+//      opCount are as in its ProcessIndex. A free slot has opCount -1.
+struct ProgramTemplate
+{
+    uint64_t hash;
+    int offset;
+    int opCount;
+};
+
+// R op outside any program, found while parsing a chunk
+//      process is the index in the chunk of the next process to open,
+//      count the repeat count of an R(start) and 0 for an R(end). lead is 1
+//      when the op came before the chunk's first A op, so it may belong to
+//      a process opened in an earlier chunk.
+struct RepeatMarker
+{
+    int process;
+    long long count;
+    int lead;
+};
+
+// Meta data body chunk, parsed on its own thread
+//      firstA is the index of the first A op in the chunk, -1 if none. The
+//      cycles of the ops before it are kept in leadProcCycles and
+//      leadIoCycles, split by device in leadDeviceCycles, since they belong to a process opened in an earlier
+//      chunk. templates is a hash table of the programs kept in the
+//      chunk's ops, so a program seen again can share them. markers holds
+//      the R ops outside programs in file order, repeatOps counts every R
+//      op.
+struct MetaChunk
+{
+    const char *start;
+    const char *end;
+    struct MetaData meta;
+    int opCapacity;
+    int processCapacity;
+    int openProcess;
+    int firstA;
+    long long leadProcCycles;
+    long long leadIoCycles;
+    long long leadDeviceCycles[DEVICE_COUNT];
+    struct ProgramTemplate *templates;
+    int templateCapacity;
+    int templateCount;
+    struct RepeatMarker *markers;
+    int markerCapacity;
+    int markerCount;
+    int repeatOps;
+    const char *errorAt;
+};
+
+
 // Constants for legal meta data tokens
-const char META_LEGAL_COMPONENT_LETTERS[] = {'S', 'P', 'A', 'M', 'I', 'O'};
+const char META_LEGAL_COMPONENT_LETTERS[] = {'S', 'P', 'A', 'M', 'I', 'O',
+                                             'R'};
 const char *META_LEGAL_OP_STRINGS[] = {"access", "allocate", "end",
                                        "hard drive", "keyboard", "printer",
                                        "monitor", "run", "start"};
+const char *DEVICE_NAMES[] = {"Hard Drive", "Keyboard", "Printer", "Monitor"};
+const char *CACHE_LEVEL_NAMES[] = {"L1", "L2", "LLC"};
+static const int CACHE_DEFAULT_LATENCY[] = {1, 4, 12};
 
 // Begin implementation
 CfgData *processCFG(char *fileName) {
@@ -44,7 +113,7 @@ CfgData *processCFG(char *fileName) {
 
     FILE *config = fopen( fileName, "r" );       // Init file pointer
 
-    char *buffer;                                // Init main buffer
+    char *buffer = NULL;                         // Init main buffer
     size_t len = 0;                              // Required for getline
 
     int dataRead[] = {0, 0, 0, 0, 0,            // Array of data we have hit
@@ -59,9 +128,46 @@ CfgData *processCFG(char *fileName) {
     // Check to make sure config file exists
     if( config == NULL )
     {
+        free( data );
         return NULL;
     }
 
+    data->metaFilePath = NULL;
+    data->logPath = NULL;
+    data->monitorFormat = LOG_FORMAT_TEXT;
+    data->fileFormat = LOG_FORMAT_TEXT;
+
+    for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+    {
+        data->deviceChannels[device] = 1;
+        data->deviceCycleTime[device] = 0;
+    }
+
+    data->mlfqLevels = MLFQ_DEFAULT_LEVELS;
+    data->mlfqBoostInterval = MLFQ_DEFAULT_BOOST;
+
+    for( int level = 0; ( level ) < ( MLFQ_MAX_LEVELS ); level++ )
+    {
+        data->mlfqQuanta[level] = 0;
+    }
+
+    for( int level = 0; ( level ) < ( CACHE_LEVEL_COUNT ); level++ )
+    {
+        data->cacheSize[level] = 0;
+        data->cacheWays[level] = CACHE_DEFAULT_WAYS;
+        data->cacheLatency[level] = CACHE_DEFAULT_LATENCY[level];
+    }
+
+    data->cacheLineSize = CACHE_DEFAULT_LINE_SIZE;
+    data->memoryLatency = CACHE_DEFAULT_MEMORY;
+    data->swapSpace = 0;
+    data->swapKbPerCycle = SWAP_DEFAULT_KB_PER_CYCLE;
+    data->admissionControl = 0;
+    data->multiprogrammingLimit = 0;
+    data->switchTime = 0;
+    data->schedulerTime = 0;
+    data->coldCachePenalty = 0;
+
     // Main parsing loop
     // Continually gets lines from the cfg, splits said string at the ':',
     // and parses data based on keywords
@@ -131,44 +237,19 @@ CfgData *processCFG(char *fileName) {
         }
 
         // Parse CPU scheduling mode
-        // Scheduling codes are defined via preprocessor directive in header
+        // Scheduling codes come from the policy registry in Scheduler.c
         if( ( compareString( configNameBuffer, "CPU Scheduling Code" ) )
             == ( 1 ) )
         {
-            if( ( compareString( configValueBuffer, " NONE" ) ) == ( 1 ) )
-            {
-                data->cpuSchedulingCode = SCHED_NONE;
-                dataRead[2] = 1;
-            }
-            else if( ( compareString( configValueBuffer, " FCFS-N" ) ) == ( 1 ) )
-            {
-                data->cpuSchedulingCode = SCHED_FCFS_N;
-                dataRead[2] = 1;
-            }
-            else if( ( compareString( configValueBuffer, " SJF-N" ) ) == ( 1 ) )
-            {
-                data->cpuSchedulingCode = SCHED_SJF_N;
-                dataRead[2] = 1;
-            }
-            else if( ( compareString( configValueBuffer, " SRTF-N" ) ) == ( 1 ) )
-            {
-                data->cpuSchedulingCode = SCHED_SRTF_P;
-                dataRead[2] = 1;
-            }
-            else if( ( compareString( configValueBuffer, " FCFS-P" ) ) == ( 1 ) )
-            {
-                data->cpuSchedulingCode = SCHED_FCFS_P;
-                dataRead[2] = 1;
-            }
-            else if( ( compareString( configValueBuffer, " RR-P" ) ) == ( 1 ) )
-            {
-                data->cpuSchedulingCode = SCHED_RR_P;
-                dataRead[2] = 1;
-            }
-            else
+            stripString( configValueBuffer );
+            data->cpuSchedulingCode = schedulerCode( configValueBuffer );
+
+            if( ( data->cpuSchedulingCode ) < ( 0 ) )
             {
                 abort = 1;
             }
+
+            dataRead[2] = 1;
         }
 
         // Parse quantum cycle time
@@ -178,7 +259,7 @@ CfgData *processCFG(char *fileName) {
             data->quantumTimeCycles = stringToInt( configValueBuffer );
 
             // Make sure the data is within the spec bounds
-            if( ( data->quantumTimeCycles >= 100 ) ||
+            if( ( data->quantumTimeCycles >= CFG_MAX_QUANTUM ) ||
                 ( data->quantumTimeCycles <= 0 ) )
             {
                 abort = 1;
@@ -194,7 +275,8 @@ CfgData *processCFG(char *fileName) {
             data->memAvailable = stringToInt( configValueBuffer );
 
             // Make sure the data is within spec bounds, otherwise abort
-            if( ( data->memAvailable < 1 ) || ( data->memAvailable > 1048576 ) )
+            if( ( data->memAvailable < 1 ) ||
+                ( data->memAvailable > CFG_MAX_MEMORY ) )
             {
                 abort = 1;
             }
@@ -209,7 +291,8 @@ CfgData *processCFG(char *fileName) {
             data->procCycleTime = stringToInt( configValueBuffer );
 
             // Make sure the data is within spec bounds, otherwise abort
-            if( ( data->procCycleTime < 1 ) || ( data->procCycleTime > 10000 ) )
+            if( ( data->procCycleTime < 1 ) ||
+                ( data->procCycleTime > CFG_MAX_CYCLE_TIME ) )
             {
                 abort = 1;
             }
@@ -224,7 +307,8 @@ CfgData *processCFG(char *fileName) {
             data->ioCycleTime = stringToInt( configValueBuffer );
 
             // Make sure the data is within spec bounds, otherwise abort
-            if( ( data->ioCycleTime < 1 ) || ( data->ioCycleTime > 10000 ) )
+            if( ( data->ioCycleTime < 1 ) ||
+                ( data->ioCycleTime > CFG_MAX_CYCLE_TIME ) )
             {
                 abort = 1;
             }
@@ -263,6 +347,249 @@ CfgData *processCFG(char *fileName) {
             dataRead[8] = 1;
     	}
 
+        // Parse the optional log formats, both default to text
+        if( ( compareString( configNameBuffer, "Monitor Log Format" ) )
+            == ( 1 ) )
+        {
+            stripString( configValueBuffer );
+            data->monitorFormat = logFormatCode( configValueBuffer );
+
+            if( ( data->monitorFormat ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "File Log Format" ) ) == ( 1 ) )
+        {
+            stripString( configValueBuffer );
+            data->fileFormat = logFormatCode( configValueBuffer );
+
+            if( ( data->fileFormat ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        // Parse the optional MLFQ settings
+        if( ( compareString( configNameBuffer, "MLFQ Levels" ) ) == ( 1 ) )
+        {
+            data->mlfqLevels = stringToInt( configValueBuffer );
+
+            if( ( data->mlfqLevels < 1 ) ||
+                ( data->mlfqLevels > MLFQ_MAX_LEVELS ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "MLFQ Quanta (cycles)" ) )
+            == ( 1 ) )
+        {
+            if( ( parseQuantumList( configValueBuffer, data->mlfqQuanta ) )
+                == ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "MLFQ Boost Interval (msec)" ) )
+            == ( 1 ) )
+        {
+            data->mlfqBoostInterval = stringToInt( configValueBuffer );
+
+            if( ( data->mlfqBoostInterval ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        // Parse the optional per device settings, e.g.
+        // "Hard Drive Channels: 2" and "Printer Cycle Time (msec): 40"
+        for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+        {
+            char deviceKey[BUFFER_SIZE];
+
+            sprintf( deviceKey, "%s Channels", DEVICE_NAMES[device] );
+            if( ( compareString( configNameBuffer, deviceKey ) ) == ( 1 ) )
+            {
+                data->deviceChannels[device] = stringToInt( configValueBuffer );
+
+                if( ( data->deviceChannels[device] < 1 ) ||
+                    ( data->deviceChannels[device] > CFG_MAX_CHANNELS ) )
+                {
+                    abort = 1;
+                }
+            }
+
+            sprintf( deviceKey, "%s Cycle Time (msec)", DEVICE_NAMES[device] );
+            if( ( compareString( configNameBuffer, deviceKey ) ) == ( 1 ) )
+            {
+                data->deviceCycleTime[device] = stringToInt( configValueBuffer );
+
+                if( ( data->deviceCycleTime[device] < 1 ) ||
+                    ( data->deviceCycleTime[device] > CFG_MAX_CYCLE_TIME ) )
+                {
+                    abort = 1;
+                }
+            }
+        }
+
+        // Parse the optional cache model settings, e.g.
+        // "L2 Cache Size (KB): 256" and "LLC Cache Latency (nsec): 40"
+        for( int level = 0; ( level ) < ( CACHE_LEVEL_COUNT ); level++ )
+        {
+            char cacheKey[BUFFER_SIZE];
+
+            sprintf( cacheKey, "%s Cache Size (KB)", CACHE_LEVEL_NAMES[level] );
+            if( ( compareString( configNameBuffer, cacheKey ) ) == ( 1 ) )
+            {
+                data->cacheSize[level] = stringToInt( configValueBuffer );
+
+                if( ( data->cacheSize[level] < 0 ) ||
+                    ( data->cacheSize[level] > CFG_MAX_MEMORY ) )
+                {
+                    abort = 1;
+                }
+            }
+
+            sprintf( cacheKey, "%s Cache Associativity",
+                     CACHE_LEVEL_NAMES[level] );
+            if( ( compareString( configNameBuffer, cacheKey ) ) == ( 1 ) )
+            {
+                data->cacheWays[level] = stringToInt( configValueBuffer );
+
+                if( ( data->cacheWays[level] < 1 ) ||
+                    ( data->cacheWays[level] > CACHE_MAX_WAYS ) )
+                {
+                    abort = 1;
+                }
+            }
+
+            sprintf( cacheKey, "%s Cache Latency (nsec)",
+                     CACHE_LEVEL_NAMES[level] );
+            if( ( compareString( configNameBuffer, cacheKey ) ) == ( 1 ) )
+            {
+                data->cacheLatency[level] = stringToInt( configValueBuffer );
+
+                if( ( data->cacheLatency[level] ) < ( 0 ) )
+                {
+                    abort = 1;
+                }
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "Cache Line Size (bytes)" ) )
+            == ( 1 ) )
+        {
+            data->cacheLineSize = stringToInt( configValueBuffer );
+
+            // Lines are a power of two so addresses split into tag and set
+            if( ( data->cacheLineSize < 1 ) ||
+                ( data->cacheLineSize > CACHE_MAX_LINE_SIZE ) ||
+                ( ( data->cacheLineSize & ( data->cacheLineSize - 1 ) )
+                  != ( 0 ) ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "Main Memory Latency (nsec)" ) )
+            == ( 1 ) )
+        {
+            data->memoryLatency = stringToInt( configValueBuffer );
+
+            if( ( data->memoryLatency ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        // Parse the optional swapping settings
+        if( ( compareString( configNameBuffer, "Swap Space (KB)" ) ) == ( 1 ) )
+        {
+            data->swapSpace = stringToInt( configValueBuffer );
+
+            if( ( data->swapSpace < 0 ) || ( data->swapSpace > CFG_MAX_SWAP ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "Swap Transfer (KB/cycle)" ) )
+            == ( 1 ) )
+        {
+            data->swapKbPerCycle = stringToInt( configValueBuffer );
+
+            if( ( data->swapKbPerCycle < 1 ) ||
+                ( data->swapKbPerCycle > CFG_MAX_MEMORY ) )
+            {
+                abort = 1;
+            }
+        }
+
+        // Parse the optional admission control settings
+        if( ( compareString( configNameBuffer, "Admission Control" ) ) == ( 1 ) )
+        {
+            stripString( configValueBuffer );
+
+            if( ( compareString( configValueBuffer, "On" ) ) == ( 1 ) )
+            {
+                data->admissionControl = 1;
+            } else if( ( compareString( configValueBuffer, "Off" ) ) == ( 1 ) )
+            {
+                data->admissionControl = 0;
+            } else
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "Multiprogramming Limit" ) )
+            == ( 1 ) )
+        {
+            data->multiprogrammingLimit = stringToInt( configValueBuffer );
+
+            if( ( data->multiprogrammingLimit ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        // Parse the optional dispatch overheads
+        if( ( compareString( configNameBuffer, "Context Switch Time (usec)" ) )
+            == ( 1 ) )
+        {
+            data->switchTime = stringToInt( configValueBuffer );
+
+            if( ( data->switchTime ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "Scheduler Time (usec)" ) )
+            == ( 1 ) )
+        {
+            data->schedulerTime = stringToInt( configValueBuffer );
+
+            if( ( data->schedulerTime ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
+        if( ( compareString( configNameBuffer, "Cold Cache Penalty (usec)" ) )
+            == ( 1 ) )
+        {
+            data->coldCachePenalty = stringToInt( configValueBuffer );
+
+            if( ( data->coldCachePenalty ) < ( 0 ) )
+            {
+                abort = 1;
+            }
+        }
+
         if( ( abort ) == ( 1 ) )
         {
             if( ( data->logPath ) != ( NULL ) )
@@ -304,6 +631,17 @@ CfgData *processCFG(char *fileName) {
         }
     }
 
+    // Levels without a configured quantum double the one above, starting
+    // from the quantum time
+    for( int level = 0; ( level ) < ( data->mlfqLevels ); level++ )
+    {
+        if( ( data->mlfqQuanta[level] ) == ( 0 ) )
+        {
+            data->mlfqQuanta[level] = level == 0 ? data->quantumTimeCycles
+                                      : data->mlfqQuanta[level - 1] * 2;
+        }
+    }
+
     // Clean up
     fclose( config );
     free( buffer );
@@ -312,181 +650,1465 @@ CfgData *processCFG(char *fileName) {
     return data;
 }
 
-struct LinkedList *processMetaData(char *fileName) {
+int parseQuantumList( const char *list, int *quanta )
+{
     /**
      * Desc:
-     *      Parse a MetaData file into a data structure.
+     *      Parse a comma separated list of MLFQ quanta, top level first.
      *
      * Args:
-     *      fileName (char*): Path of the .mdf file to parse
+     *      list (const char*): list from the config, e.g. " 5, 10, 20"
+     *      quanta (int*): receives up to MLFQ_MAX_LEVELS quanta
      *
      * Returns:
-     *      If parsing is successful, the head of a linked list data structure
-     *      is returned, which contains all relevant data
+     *      1 if every quantum is a positive number, otherwise 0.
      */
-    struct LinkedList *metaDataHead = linkedListCreate(NULL);
-    if( ( fileName[0] ) == ( ' ' ) )
+    int level = 0;
+
+    while( ( *list ) != ( '\0' ) && ( level ) < ( MLFQ_MAX_LEVELS ) )
     {
-        for( int index = 0; ( fileName[index] ) != ( '\0' ); index++ )
+        char *end;
+        long quantum = strtol( list, &end, 10 );
+
+        if( ( end ) == ( list ) || ( quantum ) < ( 1 ) )
         {
-            fileName[index] = fileName[index + 1];
+            return 0;
+        }
+
+        quanta[level++] = (int) quantum;
+        list = end;
+
+        while( ( *list ) == ( ' ' ) || ( *list ) == ( ',' ) ||
+               ( *list ) == ( '\n' ) )
+        {
+            list++;
         }
     }
 
-    FILE *config = fopen(fileName, "r"); // Init file pointer
-    char *buffer = (char *)malloc(BUFFER_SIZE);// Init main buffer
-    size_t len = 0;                      // Required variables for
-    int hitStartFlag = 0;                // Flag for when we hit "Start"
-                                         // flag in metadata file
+    return level > 0;
+}
 
-    // Make sure the file pointer isnt null
-    if( ( config ) == ( NULL ) )
+int internOpString( const char *opString, size_t length )
+{
+    /**
+     * Desc:
+     *      Turn an op string into its op code. The candidate is picked from
+     *      the length and first char, so at most one string is compared.
+     *
+     * Args:
+     *      opString (const char*): op string, does not need to be null
+     *                              terminated
+     *      length (size_t): number of chars in the op string
+     *
+     * Returns:
+     *      The META_OP_CODES value of the op string, or -1 if it is not a
+     *      legal op string.
+     */
+    int opCode = -1;
+
+    if( ( length ) == ( 0 ) )
     {
-        return NULL;
+        return -1;
     }
 
-    // Main parsing loop
-    // Continually gets lines from the cfg, splits said string at the ':',
-    // and parses data based on keywords
-    while( 1 )
+    switch( length )
     {
-        // Read line from file
-        // If there is a read error abort
-        if( ( getline( &buffer, &len, config ) ) == ( -1 ) )
-        {
+        case 3:
+            opCode = opString[0] == 'e' ? OP_END :
+                     opString[0] == 'r' ? OP_RUN : -1;
             break;
-        }
-        stripString( buffer );
-        // Check if line read is the Start flag
-        // If it is, parsing of data may begin
-        if( ( compareString( buffer, "Start Program Meta-Data Code:" ) )
-            == ( 1 ) )
-        {
-            hitStartFlag = 1;
-            continue;
-        }
 
-        if( ( hitStartFlag ) == 0)
-        {
-            continue;
-        }
-
-        if( ( compareString( buffer, "End Program Meta-Data Code." ) ) == ( 1 ) )
-        {
+        case 5:
+            opCode = OP_START;
             break;
-        }
 
-        char left[BUFFER_SIZE];
-        char right[BUFFER_SIZE];
+        case 6:
+            opCode = OP_ACCESS;
+            break;
 
-        if( ( splitString( buffer, left, right, ';' ) ) != ( 1 ) )
-        {
+        case 7:
+            opCode = opString[0] == 'p' ? OP_PRINTER :
+                     opString[0] == 'm' ? OP_MONITOR : -1;
             break;
-        }
 
-        do
-        {
-            char *componentLetter = malloc( sizeof( char ) );
-            char *opString = malloc( sizeof( char ) * BUFFER_SIZE );
-            int  *cycleTime = malloc( sizeof( int ) );
+        case 8:
+            opCode = opString[0] == 'a' ? OP_ALLOCATE :
+                     opString[0] == 'k' ? OP_KEYBOARD : -1;
+            break;
 
-            if( ( left[0] ) == ( ' ' ) )
-            {
-                for( int index = 0; ( left[index] ) != ( '\0' ); index++ )
-                {
-                    left[index] = left[index + 1];
-                }
-            }
+        case 10:
+            opCode = OP_HARD_DRIVE;
+            break;
+    }
 
-            int elementsRead = sscanf(left, "%c(%[^)])%d", componentLetter,
-                                       opString, cycleTime);
+    if( ( opCode ) < ( 0 ) ||
+        ( memcmp( opString, META_LEGAL_OP_STRINGS[opCode], length ) ) != ( 0 ) )
+    {
+        return -1;
+    }
 
-            int error_occured = 0;
+    return opCode;
+}
 
-            if( ( elementsRead ) != ( 3 ) )
-            {
-                error_occured = 1;
-            }
+static int isMarkerLine( const char *line, const char *end, const char *marker )
+{
+    /**
+     * Desc:
+     *      Check if a line matches a marker the way stripString and
+     *      compareString would: one leading space is ignored and the line
+     *      must end right after the marker.
+     *
+     * Args:
+     *      line (const char*): first char of the line
+     *      end (const char*): end of the buffer
+     *      marker (const char*): marker text
+     *
+     * Returns:
+     *      1 if the line is the marker, otherwise 0.
+     */
+    if( ( line ) < ( end ) && ( *line ) == ( ' ' ) )
+    {
+        line++;
+    }
 
-            int found = 0;
-            for( int index = 0; ( index ) < ( 6 ); index++ )
-            {
-                if( componentLetter != NULL &&
-                    *componentLetter == META_LEGAL_COMPONENT_LETTERS[index] )
-                {
-                    found = 1;
-                }
+    while( ( *marker ) != ( '\0' ) )
+    {
+        if( ( line ) >= ( end ) || ( *line ) != ( *marker ) )
+        {
+            return 0;
+        }
+
+        line++;
+        marker++;
+    }
+
+    return ( line ) >= ( end ) || ( *line ) == ( '\n' );
+}
+
+static int parseMetaOp( const char *start, const char *end,
+                        const char *openParen, const char *closeParen,
+                        char *componentLetter, int *opIndex,
+                        long long *cycleTime )
+{
+    /**
+     * Desc:
+     *      Validate and convert one op, everything between two delimiters.
+     *      Accepts exactly what sscanf( op, "%c(%[^)])%d" ) followed by the
+     *      component letter and op string table checks accepted.
+     *
+     * Args:
+     *      start (const char*): first char of the op
+     *      end (const char*): the delimiter after the op
+     *      openParen (const char*): first '(' in the op, or NULL
+     *      closeParen (const char*): first ')' after openParen, or NULL
+     *      componentLetter (char*): receives the component letter
+     *      opIndex (int*): receives the op code of the op string
+     *      cycleTime (long long*): receives the cycle count
+     *
+     * Returns:
+     *      1 if the op is legal, otherwise 0.
+     */
+    int found = 0;
+
+    if( ( start ) < ( end ) && ( *start ) == ( ' ' ) )
+    {
+        start++;
+    }
+
+    if( ( start ) >= ( end ) || ( openParen ) != ( start + 1 ) ||
+        ( closeParen ) == ( NULL ) || ( closeParen ) <= ( openParen + 1 ) )
+    {
+        return 0;
+    }
+
+    *componentLetter = *start;
+    for( size_t index = 0; ( index ) < ( sizeof( META_LEGAL_COMPONENT_LETTERS ) );
+         index++ )
+    {
+        if( ( *componentLetter ) == ( META_LEGAL_COMPONENT_LETTERS[index] ) )
+        {
+            found = 1;
+        }
+    }
+
+    if( ( found ) != ( 1 ) )
+    {
+        return 0;
+    }
+
+    *opIndex = internOpString( openParen + 1, closeParen - openParen - 1 );
+    if( ( *opIndex ) < ( 0 ) )
+    {
+        return 0;
+    }
+
+    // The cycle digits always stop at the delimiter, which isn't a digit
+    if( ( parseCycles( closeParen + 1, cycleTime ) ) == ( 0 ) )
+    {
+        return 0;
+    }
+
+    // A repeat group starts or ends, and runs at least once
+    if( ( *componentLetter ) == ( 'R' ) )
+    {
+        return ( *opIndex ) == ( OP_END ) ||
+               ( ( *opIndex ) == ( OP_START ) && ( *cycleTime ) > ( 0 ) );
+    }
+
+    return 1;
+}
+
+static void addBurstCycles( long long *procCycles, long long *ioCycles,
+                            long long *deviceCycles, char component,
+                            int opCode, long long cycles )
+{
+    /**
+     * Desc:
+     *      Count an op into a burst estimate.
+     *
+     * Args:
+     *      procCycles (long long*): P cycles so far
+     *      ioCycles (long long*): I/O cycles so far
+     *      deviceCycles (long long*): I/O cycles so far, per DEVICE_CLASSES
+     *      component (char): component letter of the op
+     *      opCode (int): op code of the op
+     *      cycles (long long): cycle count of the op
+     */
+    int device = deviceClass( opCode );
+
+    if( ( component ) == ( 'P' ) )
+    {
+        *procCycles += cycles;
+    }
+    else if( ( component ) == ( 'I' ) || ( component ) == ( 'O' ) )
+    {
+        *ioCycles += cycles;
+
+        if( ( device ) >= ( 0 ) )
+        {
+            deviceCycles[device] += cycles;
+        }
+    }
+}
+
+static uint64_t hashProgram( const struct MetaOp *ops, int count )
+{
+    /**
+     * Desc:
+     *      FNV-1a hash of the ops of a program.
+     *
+     * Args:
+     *      ops (const struct MetaOp*): A(start) of the program
+     *      count (int): number of ops, the A(start) included
+     *
+     * Returns:
+     *      The hash.
+     */
+    uint64_t hash = 14695981039346656037ULL;
+
+    for( int index = 0; ( index ) < ( count ); index++ )
+    {
+        uint64_t fields[] = { (uint64_t) ops[index].component,
+                              (uint64_t) ops[index].opCode,
+                              (uint64_t) ops[index].cycles };
+
+        for( int field = 0; ( field ) < ( 3 ); field++ )
+        {
+            hash ^= fields[field];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
+
+static int sameProgram( const struct MetaOp *first,
+                        const struct MetaOp *second, int count )
+{
+    for( int index = 0; ( index ) < ( count ); index++ )
+    {
+        if( ( first[index].component ) != ( second[index].component ) ||
+            ( first[index].opCode ) != ( second[index].opCode ) ||
+            ( first[index].cycles ) != ( second[index].cycles ) )
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static int shareProgram( struct MetaChunk *chunk, struct ProcessIndex *process )
+{
+    /**
+     * Desc:
+     *      Look up a just closed program in the chunk's templates. A
+     *      program seen before is pointed at the kept copy, otherwise it
+     *      is kept as a new template.
+     *
+     * Args:
+     *      chunk (struct MetaChunk*): chunk being parsed
+     *      process (struct ProcessIndex*): process closed by an A(end),
+     *                                      its ops the last in the chunk
+     *
+     * Returns:
+     *      1 if the process now shares an earlier copy and its own ops can
+     *      be dropped, 0 if not.
+     */
+    const struct MetaOp *ops = chunk->meta.ops + process->offset;
+    int count = process->opCount + 1;
+    uint64_t hash = hashProgram( ops, count );
+    int slot;
+
+    // Keep the table at most half full
+    if( ( chunk->templateCount * 2 ) >= ( chunk->templateCapacity ) )
+    {
+        int capacity = chunk->templateCapacity > 0 ?
+                       chunk->templateCapacity * 2 : 64;
+        struct ProgramTemplate *grown = malloc( sizeof( struct ProgramTemplate )
+                                                * capacity );
+
+        if( ( grown ) == ( NULL ) )
+        {
+            return 0;
+        }
+
+        for( slot = 0; ( slot ) < ( capacity ); slot++ )
+        {
+            grown[slot].opCount = -1;
+        }
+
+        for( int old = 0; ( old ) < ( chunk->templateCapacity ); old++ )
+        {
+            if( ( chunk->templates[old].opCount ) < ( 0 ) )
+            {
+                continue;
+            }
+
+            slot = chunk->templates[old].hash & ( capacity - 1 );
+            while( ( grown[slot].opCount ) >= ( 0 ) )
+            {
+                slot = ( slot + 1 ) & ( capacity - 1 );
+            }
+            grown[slot] = chunk->templates[old];
+        }
+
+        free( chunk->templates );
+        chunk->templates = grown;
+        chunk->templateCapacity = capacity;
+    }
+
+    slot = hash & ( chunk->templateCapacity - 1 );
+    while( ( chunk->templates[slot].opCount ) >= ( 0 ) )
+    {
+        struct ProgramTemplate *kept = &chunk->templates[slot];
+
+        if( ( kept->hash ) == ( hash ) && ( kept->opCount ) == ( process->opCount )
+            && ( sameProgram( chunk->meta.ops + kept->offset, ops, count ) )
+               == ( 1 ) )
+        {
+            process->offset = kept->offset;
+            return 1;
+        }
+
+        slot = ( slot + 1 ) & ( chunk->templateCapacity - 1 );
+    }
+
+    chunk->templates[slot].hash = hash;
+    chunk->templates[slot].offset = process->offset;
+    chunk->templates[slot].opCount = process->opCount;
+    chunk->templateCount++;
+    return 0;
+}
+
+static int addMetaOp( struct MetaChunk *chunk, char component, int opCode,
+                      long long cycles )
+{
+    /**
+     * Desc:
+     *      Append an op to a chunk and keep its process index up to date.
+     *      An A(start) opens a process, and any other A op closes it. Cycles
+     *      before the first A op belong to a process opened in an earlier
+     *      chunk and are kept aside for stitching. A process closed by its
+     *      A(end) that repeats an earlier program in the chunk shares that
+     *      program's ops, and its own are dropped. R ops outside a process
+     *      are kept as markers for orderPrograms.
+     *
+     * Args:
+     *      chunk (struct MetaChunk*): chunk being parsed
+     *      component (char): component letter of the op
+     *      opCode (int): op code of the op
+     *      cycles (long long): cycle count of the op
+     *
+     * Returns:
+     *      1 if the op was added, 0 if memory ran out.
+     */
+    struct MetaData *meta = &chunk->meta;
+
+    // Keep one spare slot for the terminating A(end)
+    if( ( meta->opCount + 1 ) >= ( chunk->opCapacity ) )
+    {
+        struct MetaOp *grown = realloc( meta->ops,
+            sizeof( struct MetaOp ) * chunk->opCapacity * 2 );
+        if( ( grown ) == ( NULL ) )
+        {
+            return 0;
+        }
+
+        meta->ops = grown;
+        chunk->opCapacity *= 2;
+    }
+
+    if( ( component ) == ( 'A' ) )
+    {
+        if( ( chunk->firstA ) < ( 0 ) )
+        {
+            chunk->firstA = meta->opCount;
+        }
+
+        if( ( chunk->openProcess ) >= ( 0 ) )
+        {
+            struct ProcessIndex *process = &meta->processes[chunk->openProcess];
+            int offset = process->offset;
+
+            process->opCount = meta->opCount - process->offset - 1;
+            chunk->openProcess = -1;
+
+            // The kept copy already ends in an A(end)
+            if( ( opCode ) == ( OP_END ) &&
+                ( shareProgram( chunk, process ) ) == ( 1 ) )
+            {
+                meta->opCount = offset;
+                return 1;
             }
+        }
 
-            if( ( found ) != ( 1 ) )
+        if( ( opCode ) == ( OP_START ) )
+        {
+            if( ( meta->programCount ) >= ( chunk->processCapacity ) )
             {
-                error_occured = 1;
+                struct ProcessIndex *grown = realloc( meta->processes,
+                    sizeof( struct ProcessIndex ) * chunk->processCapacity * 2 );
+                if( ( grown ) == ( NULL ) )
+                {
+                    return 0;
+                }
+
+                meta->processes = grown;
+                chunk->processCapacity *= 2;
             }
 
-            found = 0;
-            for(int index = 0; ( index ) < ( 9 ); index++)
+            chunk->openProcess = meta->programCount++;
+            meta->processes[chunk->openProcess].offset = meta->opCount;
+            meta->processes[chunk->openProcess].opCount = 0;
+            meta->processes[chunk->openProcess].procCycles = 0;
+            meta->processes[chunk->openProcess].ioCycles = 0;
+            memset( meta->processes[chunk->openProcess].deviceCycles, 0,
+                    sizeof( long long ) * DEVICE_COUNT );
+            meta->processes[chunk->openProcess].repeatDepth = 0;
+            meta->processes[chunk->openProcess].sourceOps = NULL;
+        }
+    }
+    else if( ( component ) == ( 'R' ) )
+    {
+        chunk->repeatOps++;
+
+        // Groups around whole programs are ordered once the file is parsed
+        if( ( chunk->openProcess ) < ( 0 ) )
+        {
+            if( ( chunk->markerCount ) >= ( chunk->markerCapacity ) )
             {
-                if( opString != NULL &&
-                    compareString(opString, META_LEGAL_OP_STRINGS[index]) == 1 )
+                int capacity = chunk->markerCapacity > 0 ?
+                               chunk->markerCapacity * 2 : 8;
+                struct RepeatMarker *grown = realloc( chunk->markers,
+                    sizeof( struct RepeatMarker ) * capacity );
+                if( ( grown ) == ( NULL ) )
                 {
-                    found = 1;
+                    return 0;
                 }
+
+                chunk->markers = grown;
+                chunk->markerCapacity = capacity;
             }
 
-            if(found != 1)
+            chunk->markers[chunk->markerCount].process = meta->programCount;
+            chunk->markers[chunk->markerCount].count =
+                opCode == OP_START ? cycles : 0;
+            chunk->markers[chunk->markerCount].lead = chunk->firstA < 0;
+            chunk->markerCount++;
+        }
+    }
+    else
+    {
+        long long *procCycles = &chunk->leadProcCycles;
+        long long *ioCycles = &chunk->leadIoCycles;
+        long long *deviceCycles = chunk->leadDeviceCycles;
+
+        if( ( chunk->openProcess ) >= ( 0 ) )
+        {
+            procCycles = &meta->processes[chunk->openProcess].procCycles;
+            ioCycles = &meta->processes[chunk->openProcess].ioCycles;
+            deviceCycles = meta->processes[chunk->openProcess].deviceCycles;
+        }
+
+        if( ( chunk->firstA ) < ( 0 ) || ( chunk->openProcess ) >= ( 0 ) )
+        {
+            addBurstCycles( procCycles, ioCycles, deviceCycles, component,
+                            opCode, cycles );
+        }
+    }
+
+    meta->ops[meta->opCount].component = component;
+    meta->ops[meta->opCount].opCode = opCode;
+    meta->ops[meta->opCount].count = 1;
+    meta->ops[meta->opCount].source = -1;
+    meta->ops[meta->opCount].cycles = cycles;
+    meta->opCount++;
+    return 1;
+}
+
+static void *parseMetaChunk( void *chunkPointer )
+{
+    /**
+     * Desc:
+     *      Parse the ops in one chunk of the meta data body. Runs on its own
+     *      thread when the body is parsed in parallel.
+     *
+     * Args:
+     *      chunkPointer (void*): struct MetaChunk to parse. The chunk must
+     *                            start at the beginning of an op and end
+     *                            right after a delimiter.
+     *
+     * Returns:
+     *      chunkPointer. chunk->errorAt is left NULL unless an illegal op
+     *      was found or memory ran out.
+     */
+    struct MetaChunk *chunk = chunkPointer;
+    const char *opStart = chunk->start;
+    const char *openParen = NULL;
+    const char *closeParen = NULL;
+
+    chunk->opCapacity = 64;
+    chunk->processCapacity = 8;
+    chunk->openProcess = -1;
+    chunk->firstA = -1;
+    chunk->leadProcCycles = 0;
+    chunk->leadIoCycles = 0;
+    memset( chunk->leadDeviceCycles, 0, sizeof( long long ) * DEVICE_COUNT );
+    chunk->templates = NULL;
+    chunk->templateCapacity = 0;
+    chunk->templateCount = 0;
+    chunk->markers = NULL;
+    chunk->markerCapacity = 0;
+    chunk->markerCount = 0;
+    chunk->repeatOps = 0;
+    chunk->errorAt = NULL;
+    chunk->meta.ops = malloc( sizeof( struct MetaOp ) * chunk->opCapacity );
+    chunk->meta.opCount = 0;
+    chunk->meta.processes = malloc( sizeof( struct ProcessIndex ) *
+                                    chunk->processCapacity );
+    chunk->meta.programCount = 0;
+
+    // Walks the delimiters a block at a time. Ops end at a ';' or '.', and
+    // whatever is left at the end of a line without one is ignored.
+    for( const char *block = chunk->start;
+         ( block ) < ( chunk->end ) && ( chunk->errorAt ) == ( NULL );
+         block += SCAN_BLOCK_SIZE )
+    {
+        struct DelimiterMasks masks;
+        scanDelimiters( block, &masks );
+
+        uint64_t delimiters = masks.semicolons | masks.periods |
+                              masks.newlines | masks.openParens |
+                              masks.closeParens;
+
+        while( ( delimiters ) != ( 0 ) )
+        {
+            const char *at = block + __builtin_ctzll( delimiters );
+            delimiters &= delimiters - 1;
+
+            if( ( at ) >= ( chunk->end ) )
             {
-                error_occured = 1;
+                break;
             }
 
-            // If there was a read error (eg unepected syntax) abort
-            if( ( error_occured ) != ( 0 ) )
+            switch( *at )
             {
-                if( ( metaDataHead ) == ( NULL ) )
-                {
-                    return NULL;
-                }
-                else
+                case '(':
+                    if( ( openParen ) == ( NULL ) )
+                    {
+                        openParen = at;
+                    }
+                    break;
+
+                case ')':
+                    if( ( openParen ) != ( NULL ) && ( closeParen ) == ( NULL ) )
+                    {
+                        closeParen = at;
+                    }
+                    break;
+
+                case '\n':
+                    opStart = at + 1;
+                    openParen = NULL;
+                    closeParen = NULL;
+                    break;
+
+                default:
                 {
-                    // Free up what was done in the linked list
-                    while( ( metaDataHead ) != ( NULL ) )
+                    char componentLetter;
+                    int opIndex;
+                    long long cycleTime;
+
+                    // If there was a read error (eg unepected syntax) stop
+                    if( ( parseMetaOp( opStart, at, openParen, closeParen,
+                                       &componentLetter, &opIndex, &cycleTime ) )
+                        == ( 0 ) ||
+                        ( addMetaOp( chunk, componentLetter, opIndex,
+                                     cycleTime ) ) == ( 0 ) )
                     {
-                        if( ( metaDataHead->data ) != ( NULL ) )
-                        {
-                            free( metaDataHead->data[0] );
-                            free( metaDataHead->data[1] );
-                            free( metaDataHead->data[2] );
-                            free( metaDataHead->data );
-                        }
-
-                        struct LinkedList *toDelete = metaDataHead;
-                        metaDataHead = metaDataHead->next;
-                        free( toDelete );
+                        chunk->errorAt = opStart;
+                        return chunk;
                     }
 
-                    // Free up all malloc'd helper variables and close the file
-                    // handle
-                    free( componentLetter );
-                    free( opString );
-                    free( cycleTime );
-                    free( buffer );
-                    fclose( config );
-                    return NULL;
+                    opStart = at + 1;
+                    openParen = NULL;
+                    closeParen = NULL;
+                    break;
                 }
             }
+        }
+    }
+
+    return chunk;
+}
+
+static const char *findMarkerLine( const char *from, const char *end,
+                                   const char *marker )
+{
+    /**
+     * Desc:
+     *      Find the first line at or after from that is the marker, as
+     *      isMarkerLine checks it.
+     *
+     * Args:
+     *      from (const char*): start of a line
+     *      end (const char*): end of the buffer
+     *      marker (const char*): marker text
+     *
+     * Returns:
+     *      Start of the marker line, or end if there isn't one.
+     */
+    size_t markerLength = strlen( marker );
+    const char *search = from;
+
+    while( ( search ) < ( end ) )
+    {
+        const char *found = memmem( search, end - search, marker,
+                                    markerLength );
+        const char *line;
+
+        if( ( found ) == ( NULL ) )
+        {
+            break;
+        }
+
+        line = found;
+        if( ( line ) > ( from ) && ( line[-1] ) == ( ' ' ) )
+        {
+            line--;
+        }
 
-            void **dataArray = malloc( sizeof( void* ) * 3 );
-            dataArray[0] = componentLetter;
-            dataArray[1] = opString;
-            dataArray[2] = cycleTime;
+        if( ( ( line ) == ( from ) || ( line[-1] ) == ( '\n' ) ) &&
+            ( isMarkerLine( line, end, marker ) ) == ( 1 ) )
+        {
+            return line;
+        }
 
-            linkedListAppend( metaDataHead, dataArray );
-        } while( ( splitString( right, left, right, ';' ) ) != ( 0 ) ||
-                 ( splitString( right, left, right, '.' ) ) != ( 0 ) );
+        search = found + 1;
     }
 
-    fclose( config );
-    free( buffer );
-    return metaDataHead;
+    return end;
+}
+
+static const char *nextChunkStart( const char *at, const char *end )
+{
+    /**
+     * Desc:
+     *      Move a chunk boundary forward to just past the next ';', '.' or
+     *      newline, where the parser holds no partial op.
+     *
+     * Args:
+     *      at (const char*): wanted boundary
+     *      end (const char*): end of the meta data body
+     *
+     * Returns:
+     *      The adjusted boundary, at most end.
+     */
+    while( ( at ) < ( end ) )
+    {
+        char current = *at++;
+
+        if( ( current ) == ( ';' ) || ( current ) == ( '.' ) ||
+            ( current ) == ( '\n' ) )
+        {
+            return at;
+        }
+    }
+
+    return end;
+}
+
+static int stitchMetaChunks( struct MetaChunk *chunks, int chunkCount,
+                             struct MetaData *meta )
+{
+    /**
+     * Desc:
+     *      Join the ops and process indexes of parsed chunks, closing
+     *      processes that run across chunk edges.
+     *
+     * Args:
+     *      chunks (struct MetaChunk*): parsed chunks in file order
+     *      chunkCount (int): number of chunks
+     *      meta (struct MetaData*): receives the joined meta data
+     *
+     * Returns:
+     *      1 on success, 0 if memory ran out.
+     */
+    int totalOps = 0;
+    int totalProcesses = 0;
+    int openProcess = -1;
+
+    for( int index = 0; ( index ) < ( chunkCount ); index++ )
+    {
+        totalOps += chunks[index].meta.opCount;
+        totalProcesses += chunks[index].meta.programCount;
+    }
+
+    meta->ops = malloc( sizeof( struct MetaOp ) * ( totalOps + 1 ) );
+    meta->processes = malloc( sizeof( struct ProcessIndex ) *
+                              ( totalProcesses + 1 ) );
+    meta->opCount = 0;
+    meta->programCount = 0;
+    meta->steps = NULL;
+    meta->sourceOps = NULL;
+
+    if( ( meta->ops ) == ( NULL ) || ( meta->processes ) == ( NULL ) )
+    {
+        return 0;
+    }
+
+    for( int index = 0; ( index ) < ( chunkCount ); index++ )
+    {
+        struct MetaChunk *chunk = &chunks[index];
+        int firstProcess = meta->programCount;
+
+        // The process left open by earlier chunks owns this chunk's lead ops
+        if( ( openProcess ) >= ( 0 ) )
+        {
+            meta->processes[openProcess].procCycles += chunk->leadProcCycles;
+            meta->processes[openProcess].ioCycles += chunk->leadIoCycles;
+            for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+            {
+                meta->processes[openProcess].deviceCycles[device] +=
+                    chunk->leadDeviceCycles[device];
+            }
+
+            if( ( chunk->firstA ) >= ( 0 ) )
+            {
+                meta->processes[openProcess].opCount = meta->opCount +
+                    chunk->firstA - meta->processes[openProcess].offset - 1;
+                openProcess = -1;
+            }
+        }
+
+        memcpy( meta->ops + meta->opCount, chunk->meta.ops,
+                sizeof( struct MetaOp ) * chunk->meta.opCount );
+
+        for( int process = 0; ( process ) < ( chunk->meta.programCount );
+             process++ )
+        {
+            meta->processes[meta->programCount] = chunk->meta.processes[process];
+            meta->processes[meta->programCount].offset += meta->opCount;
+            meta->programCount++;
+        }
+
+        if( ( chunk->openProcess ) >= ( 0 ) )
+        {
+            openProcess = firstProcess + chunk->openProcess;
+        }
+
+        meta->opCount += chunk->meta.opCount;
+    }
+
+    // Close a process left open at the end of the file
+    if( ( openProcess ) >= ( 0 ) )
+    {
+        struct ProcessIndex *process = &meta->processes[openProcess];
+        process->opCount = meta->opCount - process->offset - 1;
+    }
+
+    return 1;
+}
+
+static int measureProgram( const struct MetaData *meta,
+                           struct ProcessIndex *process )
+{
+    /**
+     * Desc:
+     *      Work out the burst estimate of a process, counting every repeat
+     *      group as many times as it runs, and how deep its groups nest.
+     *      Checks the groups are balanced and that the repeat counts can be
+     *      multiplied out: the estimate must fit a long long at any cycle
+     *      time up to CFG_MAX_CYCLE_TIME, and so must the memory its
+     *      M(allocate) ops declare.
+     *
+     * Args:
+     *      meta (const struct MetaData*): stitched meta data
+     *      process (struct ProcessIndex*): process to measure
+     *
+     * Returns:
+     *      1 on success, 0 if a group is unbalanced, empty, nested too
+     *      deep or repeats too many cycles.
+     */
+    const long long limit = LLONG_MAX / CFG_MAX_CYCLE_TIME;
+    struct ProcessIndex starts[META_MAX_REPEAT_DEPTH];
+    long long counts[META_MAX_REPEAT_DEPTH];
+    long long runs[META_MAX_REPEAT_DEPTH + 1] = { 1 };
+    long long footprint = 0;
+    struct ProcessIndex burst;
+    int depth = 0;
+
+    burst.procCycles = 0;
+    burst.ioCycles = 0;
+    memset( burst.deviceCycles, 0, sizeof( burst.deviceCycles ) );
+
+    for( int index = 1; ( index ) <= ( process->opCount ); index++ )
+    {
+        const struct MetaOp *op = &meta->ops[process->offset + index];
+        long long total = burst.procCycles + burst.ioCycles;
+
+        if( ( op->component ) == ( 'R' ) && ( op->opCode ) == ( OP_START ) )
+        {
+            if( ( depth ) == ( META_MAX_REPEAT_DEPTH ) ||
+                __builtin_mul_overflow( runs[depth], op->cycles,
+                                        &runs[depth + 1] ) )
+            {
+                return 0;
+            }
+
+            starts[depth] = burst;
+            counts[depth] = op->cycles;
+            depth++;
+
+            if( ( depth ) > ( process->repeatDepth ) )
+            {
+                process->repeatDepth = depth;
+            }
+        }
+        else if( ( op->component ) == ( 'R' ) )
+        {
+            long long group;
+            long long extra;
+
+            // An empty group would only move the cursor back onto its end
+            if( ( depth ) == ( 0 ) || ( ( op[-1].component ) == ( 'R' ) &&
+                                        ( op[-1].opCode ) == ( OP_START ) ) )
+            {
+                return 0;
+            }
+
+            // The group is already counted once, add the other runs
+            depth--;
+            group = total - starts[depth].procCycles - starts[depth].ioCycles;
+            if( __builtin_mul_overflow( group, counts[depth] - 1, &extra ) ||
+                ( extra ) > ( limit - total ) )
+            {
+                return 0;
+            }
+
+            burst.procCycles += ( burst.procCycles - starts[depth].procCycles )
+                                * ( counts[depth] - 1 );
+            burst.ioCycles += ( burst.ioCycles - starts[depth].ioCycles ) *
+                              ( counts[depth] - 1 );
+            for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+            {
+                burst.deviceCycles[device] += ( burst.deviceCycles[device] -
+                    starts[depth].deviceCycles[device] ) * ( counts[depth] - 1 );
+            }
+        }
+        else if( ( op->component ) == ( 'M' ) )
+        {
+            long long kb;
+
+            if( ( op->opCode ) == ( OP_ALLOCATE ) &&
+                ( __builtin_mul_overflow( op->cycles % 1000, runs[depth], &kb ) ||
+                  __builtin_add_overflow( footprint, kb, &footprint ) ) )
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            if( ( ( op->component ) == ( 'P' ) || ( op->component ) == ( 'I' ) ||
+                  ( op->component ) == ( 'O' ) ) &&
+                ( op->cycles ) > ( limit - total ) )
+            {
+                return 0;
+            }
+
+            addBurstCycles( &burst.procCycles, &burst.ioCycles,
+                            burst.deviceCycles, op->component, op->opCode,
+                            op->cycles );
+        }
+    }
+
+    process->procCycles = burst.procCycles;
+    process->ioCycles = burst.ioCycles;
+    memcpy( process->deviceCycles, burst.deviceCycles,
+            sizeof( burst.deviceCycles ) );
+    return ( depth ) == ( 0 );
+}
+
+static int orderPrograms( struct MetaData *meta,
+                          const struct MetaChunk *chunks, int chunkCount )
+{
+    /**
+     * Desc:
+     *      Keep the repeat groups around whole programs as steps of the
+     *      process order, and count the processes they start. The groups
+     *      are only run when the processes are created, see nextProgram.
+     *
+     * Args:
+     *      meta (struct MetaData*): stitched meta data
+     *      chunks (const struct MetaChunk*): parsed chunks in file order
+     *      chunkCount (int): number of chunks
+     *
+     * Returns:
+     *      1 on success, 0 if a group is unbalanced, nested too deep, has
+     *      no programs, starts more processes than fit an int or memory ran
+     *      out.
+     */
+    long long processes[META_MAX_REPEAT_DEPTH + 1] = { 0 };
+    long long counts[META_MAX_REPEAT_DEPTH];
+    int stepCapacity = meta->programCount;
+    int stepCount = 0;
+    int depth = 0;
+    int next = 0;
+    int base = 0;
+    int insideProcess = 0;
+    int grouped = 0;
+    int result = 1;
+
+    for( int chunk = 0; ( chunk ) < ( chunkCount ); chunk++ )
+    {
+        stepCapacity += chunks[chunk].markerCount;
+    }
+
+    struct ProgramStep *steps = malloc( sizeof( struct ProgramStep ) *
+                                        ( stepCapacity + 1 ) );
+    if( ( steps ) == ( NULL ) )
+    {
+        return 0;
+    }
+
+    // The end of the file acts as one more marker, after the last chunk
+    for( int chunk = 0; ( chunk ) <= ( chunkCount ) && ( result ) == ( 1 );
+         chunk++ )
+    {
+        int markerCount = chunk < chunkCount ? chunks[chunk].markerCount : 1;
+
+        for( int marker = 0; ( marker ) < ( markerCount ) && ( result ) == ( 1 );
+             marker++ )
+        {
+            struct RepeatMarker last = { meta->programCount - base, -1, 0 };
+            const struct RepeatMarker *at = chunk < chunkCount ?
+                &chunks[chunk].markers[marker] : &last;
+
+            // An R op before the first A op of a chunk may repeat the ops of
+            // a process opened in an earlier chunk
+            if( ( at->lead ) == ( 1 ) && ( insideProcess ) == ( 1 ) )
+            {
+                continue;
+            }
+
+            for( ; ( next ) < ( base + at->process ); next++ )
+            {
+                steps[stepCount].program = next;
+                steps[stepCount].count = 0;
+                stepCount++;
+                processes[depth]++;
+            }
+
+            if( ( at->count ) < ( 0 ) )
+            {
+                continue;
+            }
+
+            steps[stepCount].program = -1;
+            steps[stepCount].count = at->count;
+            stepCount++;
+            grouped = 1;
+
+            if( ( at->count ) > ( 0 ) )
+            {
+                result = ( depth ) < ( META_MAX_REPEAT_DEPTH );
+                if( ( result ) == ( 1 ) )
+                {
+                    counts[depth] = at->count;
+                    depth++;
+                    processes[depth] = 0;
+                }
+                continue;
+            }
+
+            // Close the innermost group, it runs its processes counts times
+            result = ( depth ) > ( 0 );
+            if( ( result ) == ( 1 ) )
+            {
+                long long group;
+
+                depth--;
+                result = ( processes[depth + 1] ) > ( 0 ) &&
+                    !__builtin_mul_overflow( processes[depth + 1],
+                                             counts[depth], &group ) &&
+                    !__builtin_add_overflow( processes[depth], group,
+                                             &processes[depth] ) &&
+                    ( processes[depth] ) <= ( INT_MAX );
+            }
+        }
+
+        if( ( chunk ) < ( chunkCount ) )
+        {
+            base += chunks[chunk].meta.programCount;
+
+            if( ( chunks[chunk].openProcess ) >= ( 0 ) )
+            {
+                insideProcess = 1;
+            }
+            else if( ( chunks[chunk].firstA ) >= ( 0 ) )
+            {
+                insideProcess = 0;
+            }
+        }
+    }
+
+    if( ( result ) == ( 0 ) || ( depth ) != ( 0 ) ||
+        ( processes[0] ) > ( INT_MAX ) )
+    {
+        free( steps );
+        return 0;
+    }
+
+    // Every program runs once, in order, without groups around them
+    if( ( grouped ) == ( 0 ) )
+    {
+        free( steps );
+        return 1;
+    }
+
+    meta->steps = steps;
+    meta->stepCount = stepCount;
+    meta->processCount = processes[0];
+    return 1;
+}
+
+static int resolveRepeats( struct MetaData *meta,
+                           const struct MetaChunk *chunks, int chunkCount )
+{
+    /**
+     * Desc:
+     *      Check the repeat groups of stitched meta data, count them into
+     *      the burst estimates and keep the groups around whole programs
+     *      for process creation. Groups inside a program are left in the
+     *      ops, they run off the process cursor.
+     *
+     * Args:
+     *      meta (struct MetaData*): stitched meta data
+     *      chunks (const struct MetaChunk*): parsed chunks in file order
+     *      chunkCount (int): number of chunks
+     *
+     * Returns:
+     *      1 on success, 0 after printing the error if the groups are
+     *      illegal.
+     */
+    for( int process = 0; ( process ) < ( meta->programCount ); process++ )
+    {
+        if( ( measureProgram( meta, &meta->processes[process] ) ) == ( 0 ) )
+        {
+            fprintf( stderr, "Unbalanced, empty, too deeply nested or too "
+                             "large repeat in process %d\n", process );
+            return 0;
+        }
+    }
+
+    if( ( orderPrograms( meta, chunks, chunkCount ) ) == ( 0 ) )
+    {
+        fprintf( stderr, "Unbalanced, too deeply nested, empty or too large "
+                         "repeat around programs\n" );
+        return 0;
+    }
+
+    return 1;
+}
+
+static void reportMetaError( const char *text, const char *errorAt )
+{
+    /**
+     * Desc:
+     *      Print the line and column of the first illegal op.
+     *
+     * Args:
+     *      text (const char*): start of the meta data file
+     *      errorAt (const char*): first char of the illegal op
+     */
+    int lineNumber = 1;
+    const char *lineStart = text;
+
+    for( const char *at = text; ( at ) < ( errorAt ); at++ )
+    {
+        if( ( *at ) == ( '\n' ) )
+        {
+            lineNumber++;
+            lineStart = at + 1;
+        }
+    }
+
+    fprintf( stderr, "Illegal meta data op at line %d, column %d\n",
+             lineNumber, (int) ( errorAt - lineStart ) + 1 );
+}
+
+void setMetaParseThreads( int threads )
+{
+    /**
+     * Desc:
+     *      Set how many threads processMetaData may use on large files.
+     *
+     * Args:
+     *      threads (int): thread count, 0 to use one per online core
+     */
+    metaParseThreads = threads;
+}
+
+struct MetaData *processMetaData(char *fileName) {
+    /**
+     * Desc:
+     *      Parse a MetaData file into a data structure.
+     *
+     * Args:
+     *      fileName (char*): Path of the .mdf file to parse
+     *
+     * Returns:
+     *      If parsing is successful, a MetaData struct holding every op in
+     *      one array and an index of the processes in it is returned
+     *      (see InputDataProcessor.h for struct details).
+     *
+     * Notes:
+     *      The whole file is read into memory and the ops are found with the
+     *      delimiter masks from MetaScanner, a block at a time, instead of
+     *      splitting copies of each line. Bodies of at least
+     *      META_PARALLEL_MIN_BYTES are split into chunks at delimiters and
+     *      parsed on several threads, then stitched back together.
+     */
+    if( ( fileName[0] ) == ( ' ' ) )
+    {
+        for( int index = 0; ( fileName[index] ) != ( '\0' ); index++ )
+        {
+            fileName[index] = fileName[index + 1];
+        }
+    }
+
+    FILE *config = fopen(fileName, "r"); // Init file pointer
+
+    // Make sure the file pointer isnt null
+    if( ( config ) == ( NULL ) )
+    {
+        return NULL;
+    }
+
+    // Read the whole file, padded so the scanner can read whole blocks
+    fseeko( config, 0, SEEK_END );
+    size_t fileSize = (size_t) ftello( config );
+    fseeko( config, 0, SEEK_SET );
+
+    char *text = malloc( fileSize + SCAN_BLOCK_SIZE );
+    if( ( text ) == ( NULL ) ||
+        ( fread( text, 1, fileSize, config ) ) != ( fileSize ) )
+    {
+        free( text );
+        fclose( config );
+        return NULL;
+    }
+    fclose( config );
+
+    return parseMetaBuffer( text, fileSize );
+}
+
+struct MetaData *parseMetaText( const char *source, size_t length )
+{
+    /**
+     * Desc:
+     *      Parse meta data held in memory, e.g. a program block sent to the
+     *      daemon, as if it was the body of a MetaData file.
+     *
+     * Args:
+     *      source (const char*): ops, without the start and end flags
+     *      length (size_t): bytes in source
+     *
+     * Returns:
+     *      The parsed MetaData, or NULL if an op is illegal.
+     */
+    static const char START_FLAG[] = "Start Program Meta-Data Code:\n";
+    static const char END_FLAG[] = "\nEnd Program Meta-Data Code.\n";
+    size_t textSize = sizeof( START_FLAG ) - 1 + length + sizeof( END_FLAG ) - 1;
+    char *text = malloc( textSize + SCAN_BLOCK_SIZE );
+
+    if( ( text ) == ( NULL ) )
+    {
+        return NULL;
+    }
+
+    memcpy( text, START_FLAG, sizeof( START_FLAG ) - 1 );
+    memcpy( text + sizeof( START_FLAG ) - 1, source, length );
+    memcpy( text + sizeof( START_FLAG ) - 1 + length, END_FLAG,
+            sizeof( END_FLAG ) - 1 );
+
+    return parseMetaBuffer( text, textSize );
+}
+
+static struct MetaData *parseMetaBuffer( char *text, size_t fileSize )
+{
+    /**
+     * Desc:
+     *      Parse the text of a MetaData file.
+     *
+     * Args:
+     *      text (char*): file text with SCAN_BLOCK_SIZE bytes of room past
+     *                    the end, freed before returning
+     *      fileSize (size_t): bytes of text
+     *
+     * Returns:
+     *      The parsed MetaData, or NULL if the text is not legal.
+     */
+    memset( text + fileSize, 0, SCAN_BLOCK_SIZE );
+
+    const char *end = text + fileSize;
+    const char *line = text;
+
+    // Skip everything up to and including the start flag
+    while( ( line ) < ( end ) &&
+           ( isMarkerLine( line, end, "Start Program Meta-Data Code:" ) )
+           == ( 0 ) )
+    {
+        const char *newline = memchr( line, '\n', end - line );
+        line = newline == NULL ? end : newline + 1;
+    }
+
+    if( ( line ) < ( end ) )
+    {
+        line = memchr( line, '\n', end - line );
+        line = line == NULL ? end : line + 1;
+    }
+
+    // The body runs up to the end flag
+    const char *bodyEnd = findMarkerLine( line, end,
+                                          "End Program Meta-Data Code." );
+    size_t bodySize = bodyEnd - line;
+    int chunkCount = 1;
+
+    if( ( bodySize ) >= ( META_PARALLEL_MIN_BYTES ) )
+    {
+        chunkCount = metaParseThreads;
+
+        if( ( chunkCount ) <= ( 0 ) )
+        {
+            chunkCount = (int) sysconf( _SC_NPROCESSORS_ONLN );
+        }
+
+        if( ( chunkCount ) > ( META_MAX_PARSE_THREADS ) )
+        {
+            chunkCount = META_MAX_PARSE_THREADS;
+        }
+
+        if( ( chunkCount ) < ( 1 ) )
+        {
+            chunkCount = 1;
+        }
+    }
+
+    struct MetaChunk *chunks = malloc( sizeof( struct MetaChunk ) * chunkCount );
+    pthread_t *threads = malloc( sizeof( pthread_t ) * chunkCount );
+    const char *chunkStart = line;
+
+    // Split the body at delimiters and parse every chunk but the first on
+    // its own thread
+    for( int index = 0; ( index ) < ( chunkCount ); index++ )
+    {
+        chunks[index].start = chunkStart;
+        chunks[index].end = index == chunkCount - 1 ? bodyEnd :
+            nextChunkStart( line + bodySize / chunkCount * ( index + 1 ),
+                            bodyEnd );
+        chunkStart = chunks[index].end;
+
+        if( ( index ) > ( 0 ) )
+        {
+            pthread_create( &threads[index], NULL, parseMetaChunk,
+                            &chunks[index] );
+        }
+    }
+
+    parseMetaChunk( &chunks[0] );
+
+    for( int index = 1; ( index ) < ( chunkCount ); index++ )
+    {
+        pthread_join( threads[index], NULL );
+    }
+
+    // The first chunk with an error holds the error a sequential parse
+    // would have stopped at
+    const char *errorAt = NULL;
+    for( int index = 0; ( index ) < ( chunkCount ) && ( errorAt ) == ( NULL );
+         index++ )
+    {
+        errorAt = chunks[index].errorAt;
+    }
+
+    struct MetaData *meta = malloc( sizeof( struct MetaData ) );
+
+    if( ( errorAt ) != ( NULL ) )
+    {
+        reportMetaError( text, errorAt );
+        free( meta );
+        meta = NULL;
+    }
+    else if( ( chunkCount ) == ( 1 ) )
+    {
+        *meta = chunks[0].meta;
+        chunks[0].meta.ops = NULL;
+        chunks[0].meta.processes = NULL;
+
+        if( ( chunks[0].openProcess ) >= ( 0 ) )
+        {
+            struct ProcessIndex *process = &meta->processes[chunks[0].openProcess];
+            process->opCount = meta->opCount - process->offset - 1;
+        }
+    }
+    else if( ( stitchMetaChunks( chunks, chunkCount, meta ) ) == ( 0 ) )
+    {
+        freeMetaData( meta );
+        meta = NULL;
+    }
+
+    // Terminate the ops with an A(end) so a cursor walking a process
+    // always stops
+    if( ( meta ) != ( NULL ) )
+    {
+        meta->ops[meta->opCount].component = 'A';
+        meta->ops[meta->opCount].opCode = OP_END;
+        meta->ops[meta->opCount].count = 1;
+        meta->ops[meta->opCount].source = -1;
+        meta->ops[meta->opCount].cycles = 0;
+        meta->sourceOps = NULL;
+        meta->processCount = meta->programCount;
+        meta->steps = NULL;
+        meta->stepCount = 0;
+    }
+
+    int repeatOps = 0;
+    for( int index = 0; ( index ) < ( chunkCount ); index++ )
+    {
+        repeatOps += chunks[index].repeatOps;
+    }
+
+    if( ( meta ) != ( NULL ) && ( repeatOps ) > ( 0 ) &&
+        ( resolveRepeats( meta, chunks, chunkCount ) ) == ( 0 ) )
+    {
+        freeMetaData( meta );
+        meta = NULL;
+    }
+
+    for( int index = 0; ( index ) < ( chunkCount ); index++ )
+    {
+        free( chunks[index].meta.ops );
+        free( chunks[index].meta.processes );
+        free( chunks[index].templates );
+        free( chunks[index].markers );
+    }
+
+    free( chunks );
+    free( threads );
+    free( text );
+    return meta;
+}
+
+void freeMetaData( struct MetaData *meta )
+{
+    /**
+     * Desc:
+     *      Free a MetaData struct and everything in it.
+     *
+     * Args:
+     *      meta (struct MetaData*): meta data returned by processMetaData
+     */
+    if( ( meta ) == ( NULL ) )
+    {
+        return;
+    }
+
+    free( meta->ops );
+    free( meta->processes );
+    free( meta->steps );
+    free( meta->sourceOps );
+    free( meta );
+}
+
+int nextProgram( const struct MetaData *meta, struct ProgramCursor *cursor )
+{
+    /**
+     * Desc:
+     *      Walk the process order of meta data one process at a time,
+     *      running the repeat groups around programs as it goes.
+     *
+     * Args:
+     *      meta (const struct MetaData*): parsed meta data
+     *      cursor (struct ProgramCursor*): position, zeroed before the
+     *                                      first process
+     *
+     * Returns:
+     *      The index in meta processes of the next process's program, or
+     *      -1 after the last process.
+     */
+    if( ( meta->steps ) == ( NULL ) )
+    {
+        return cursor->step < meta->programCount ? cursor->step++ : -1;
+    }
+
+    while( ( cursor->step ) < ( meta->stepCount ) )
+    {
+        const struct ProgramStep *step = &meta->steps[cursor->step++];
+
+        if( ( step->program ) >= ( 0 ) )
+        {
+            return step->program;
+        }
+
+        if( ( step->count ) > ( 0 ) )
+        {
+            cursor->starts[cursor->depth] = cursor->step;
+            cursor->remaining[cursor->depth] = step->count;
+            cursor->depth++;
+        }
+        else if( ( --cursor->remaining[cursor->depth - 1] ) > ( 0 ) )
+        {
+            cursor->step = cursor->starts[cursor->depth - 1];
+        }
+        else
+        {
+            cursor->depth--;
+        }
+    }
+
+    return -1;
 }
 
 
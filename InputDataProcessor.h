@@ -13,26 +13,81 @@
 #ifndef INPUTDATAPROCESSOR_H
 #define INPUTDATAPROCESSOR_H
 
-// Preprocessor directives for CPU scheduling
-#define SCHED_NONE   0;
-#define SCHED_FCFS_N 0;
-#define SCHED_SJF_N  1;
-#define SCHED_SRTF_P 2;
-#define SCHED_FCFS_P 3;
-#define SCHED_RR_P   4;
+// Config value bounds, can be raised at build time with -D
+#ifndef CFG_MAX_QUANTUM
+#define CFG_MAX_QUANTUM     100
+#endif
+#ifndef CFG_MAX_MEMORY
+#define CFG_MAX_MEMORY      1048576
+#endif
+#ifndef CFG_MAX_CYCLE_TIME
+#define CFG_MAX_CYCLE_TIME  10000
+#endif
+#ifndef CFG_MAX_CHANNELS
+#define CFG_MAX_CHANNELS    64
+#endif
+#ifndef CFG_MAX_SWAP
+#define CFG_MAX_SWAP        ( 16 * CFG_MAX_MEMORY )
+#endif
+
+// KB moved per hard drive cycle when swapping, unless configured
+#define SWAP_DEFAULT_KB_PER_CYCLE 64
+
+// Cache model limits and defaults, latencies are in nsec
+#define CACHE_MAX_WAYS          64
+#define CACHE_MAX_LINE_SIZE     4096
+#define CACHE_DEFAULT_WAYS      8
+#define CACHE_DEFAULT_LINE_SIZE 64
+#define CACHE_DEFAULT_MEMORY    100
+
+// MLFQ limits and defaults, the boost interval is in msec
+#define MLFQ_MAX_LEVELS     8
+#define MLFQ_DEFAULT_LEVELS 3
+#define MLFQ_DEFAULT_BOOST  1000
 
 // Preprocessor directives for logging
 #define LOG_MONITOR 0;
 #define LOG_FILE    1;
 #define LOG_BOTH    2;
 
+// Meta data bodies at least this big are parsed on several threads
+#ifndef META_PARALLEL_MIN_BYTES
+#define META_PARALLEL_MIN_BYTES ( 4 * 1024 * 1024 )
+#endif
+#define META_MAX_PARSE_THREADS  64
+
+// Deepest nesting of R(start)...R(end) repeat groups
+#define META_MAX_REPEAT_DEPTH   8
+
 // Imported files
 #include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <inttypes.h>
+#include <string.h>
+#include <limits.h>
 #include "StringUtilities.h"
 #include "LinkedList.h"
 
+// I/O device classes, index into DEVICE_NAMES
+enum DEVICE_CLASSES { DEVICE_HARD_DRIVE, DEVICE_KEYBOARD, DEVICE_PRINTER,
+                      DEVICE_MONITOR, DEVICE_COUNT };
+
+extern const char *DEVICE_NAMES[];
+
+// Cache levels, index into CACHE_LEVEL_NAMES
+enum CACHE_LEVELS { CACHE_L1, CACHE_L2, CACHE_LLC, CACHE_LEVEL_COUNT };
+
+extern const char *CACHE_LEVEL_NAMES[];
+
 // CFG file data struct
+//      cpuSchedulingCode is a SCHED_CODES value from Scheduler.h.
+//      deviceChannels is the number of requests each device class serves at
+//      once. A deviceCycleTime of 0 means the device uses ioCycleTime.
+//      A cache level with cacheSize 0 is left out, with every level left
+//      out M(access) ops take no time. A swapSpace of 0 turns swapping
+//      off. A multiprogrammingLimit of 0 means no limit. The dispatch
+//      overheads are in usec, 0 leaves them out.
 typedef struct {
     int version;
     char *metaFilePath;
@@ -43,11 +98,128 @@ typedef struct {
     int ioCycleTime;
     int logTo;
     char *logPath;
+    int monitorFormat;
+    int fileFormat;
+    int deviceChannels[DEVICE_COUNT];
+    int deviceCycleTime[DEVICE_COUNT];
+    int mlfqLevels;
+    int mlfqQuanta[MLFQ_MAX_LEVELS];
+    int mlfqBoostInterval;
+    int cacheSize[CACHE_LEVEL_COUNT];
+    int cacheWays[CACHE_LEVEL_COUNT];
+    int cacheLatency[CACHE_LEVEL_COUNT];
+    int cacheLineSize;
+    int memoryLatency;
+    int swapSpace;
+    int swapKbPerCycle;
+    int admissionControl;
+    int multiprogrammingLimit;
+    int switchTime;
+    int schedulerTime;
+    int coldCachePenalty;
 } CfgData;
 
+// Op codes, in the same order as META_LEGAL_OP_STRINGS
+enum META_OP_CODES { OP_ACCESS, OP_ALLOCATE, OP_END, OP_HARD_DRIVE,
+                     OP_KEYBOARD, OP_PRINTER, OP_MONITOR, OP_RUN, OP_START,
+                     OP_CODE_COUNT };
+
+// Legal meta data tokens
+//      R(start)n ... R(end)0 repeats the ops in between n times, n at least
+//      1, and must hold at least one op or program. Groups nest up to
+//      META_MAX_REPEAT_DEPTH deep, inside a program or around whole
+//      A(start)...A(end) programs, but can't cross an A op.
+extern const char META_LEGAL_COMPONENT_LETTERS[];
+extern const char *META_LEGAL_OP_STRINGS[];
+
+// One meta data op
+//      count is the number of file ops fused into this one by Coalesce.h,
+//      1 otherwise. Once coalesced, source is the index in MetaData
+//      sourceOps of the first of them, -1 before. The cycles of a fused op
+//      are the sum of theirs.
+struct MetaOp
+{
+    char component;
+    int opCode;
+    int count;
+    int source;
+    long long cycles;
+};
+
+// Process index entry, one per A(start)...A(end) program
+//      offset is the position of the A(start) in MetaData ops and opCount
+//      the number of ops after it up to the A(end). procCycles and ioCycles
+//      are the burst estimate, the P and I/O cycles of the process with
+//      its repeat groups counted as many times as they run. deviceCycles
+//      splits the I/O cycles by DEVICE_CLASSES, so each device's own cycle
+//      time can be applied. repeatDepth is how deep the repeat groups in
+//      the program nest, 0 without any.
+//      sourceOps is MetaData sourceOps, for the fused ops of the process.
+//      Processes running the same program may share one offset, the ops
+//      are read only once parsed.
+struct ProcessIndex
+{
+    int offset;
+    int opCount;
+    long long procCycles;
+    long long ioCycles;
+    long long deviceCycles[DEVICE_COUNT];
+    int repeatDepth;
+    const struct MetaOp *sourceOps;
+};
+
+// Step of the process order of a file with repeat groups around programs
+//      program is the MetaData processes entry the next process runs, or
+//      -1 for a group. count is then the repeat count of an R(start), 0
+//      for an R(end).
+struct ProgramStep
+{
+    int program;
+    long long count;
+};
+
+// Position in the process order, see nextProgram. Starts zeroed.
+struct ProgramCursor
+{
+    int step;
+    int depth;
+    int starts[META_MAX_REPEAT_DEPTH];
+    long long remaining[META_MAX_REPEAT_DEPTH];
+};
+
+// Meta data file contents
+//      ops holds the ops in file order, less those of programs repeating
+//      one parsed earlier in the same chunk, and is terminated by an extra
+//      A(end) that is not counted in opCount. Once ops are coalesced,
+//      sourceOps keeps the ops as they were in the file, otherwise it is
+//      NULL.
+//      processes holds one entry per program in the file, programCount of
+//      them. processCount is the number of processes the file starts,
+//      with the groups around programs run as many times as they repeat.
+//      Those groups are kept in steps, walked with nextProgram as the
+//      processes are created. steps is NULL when there are none and every
+//      program runs once, in order.
+struct MetaData
+{
+    struct MetaOp *ops;
+    int opCount;
+    struct ProcessIndex *processes;
+    int programCount;
+    int processCount;
+    struct ProgramStep *steps;
+    int stepCount;
+    struct MetaOp *sourceOps;
+};
+
 // Function headers
 CfgData *processCFG(char *fileName);
-struct LinkedList *processMetaData(char *fileName);
+struct MetaData *processMetaData(char *fileName);
+struct MetaData *parseMetaText( const char *source, size_t length );
+void freeMetaData( struct MetaData *meta );
+int nextProgram( const struct MetaData *meta, struct ProgramCursor *cursor );
+void setMetaParseThreads( int threads );
+int internOpString( const char *opString, size_t length );
+int parseQuantumList( const char *list, int *quanta );
 
 // End include guard
 #endif              // INPUTDATAPROCESSOR_C
@@ -63,23 +63,24 @@ struct LogFile *logFileCreate()
 {
     struct LogFile *list = malloc( sizeof( struct LogFile ) );
     list->next = NULL;
+    list->tail = list;
+    list->data = NULL;
+    list->length = 0;
     return list;
 }
 
-void logFileAppend( struct LogFile *head, char *logLine )
+void logFileAppend( struct LogFile *head, const char *logLine, size_t length )
 {
-    if( ( head->next ) == ( NULL ) )
-    {
-        head->next = (struct LogFile*) malloc( sizeof( struct LogFile));
-        head->next->data = copyString( logLine );
-        head->next->next = NULL;
-        return;
-    }
-    else
-    {
-        logFileAppend( head->next, logLine );
-        return;
-    }
+    struct LogFile *node = (struct LogFile*) malloc( sizeof( struct LogFile ) );
+
+    node->data = malloc( length );
+    memcpy( node->data, logLine, length );
+    node->length = length;
+    node->next = NULL;
+    node->tail = NULL;
+
+    head->tail->next = node;
+    head->tail = node;
 }
 
 struct Memory *memCreate()
@@ -15,6 +15,7 @@
 
 // Include header
 #include <stdlib.h>
+#include <string.h>
 #include "StringUtilities.h"
 
 // Linked list struct
@@ -24,10 +25,14 @@ struct LinkedList
     void **data;
 };
 
+// Log file list, the head node keeps track of the last node so appends
+// don't walk the list. data holds length bytes and is not always text.
 struct LogFile
 {
     struct LogFile *next;
+    struct LogFile *tail;
     char *data;
+    size_t length;
 };
 
 struct Memory
@@ -40,7 +45,7 @@ struct Memory
 struct LinkedList *linkedListCreate( void **data );
 void linkedListAppend( struct LinkedList *head, void **data );
 struct LogFile *logFileCreate();
-void logFileAppend( struct LogFile *head, char *logLine );
+void logFileAppend( struct LogFile *head, const char *logLine, size_t length );
 struct Memory *memCreate();
 void memAppend( struct Memory *head, struct MMU *block );
 
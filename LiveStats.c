@@ -0,0 +1,385 @@
+/**
+ * Name:
+ *      LiveStats.c
+ *
+ * Desc:
+ *      Implementation of LiveStats.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      There is one writer, the simulation thread, so the sequence lock
+ *      only has to keep readers from seeing a half written update. The
+ *      writer never waits on readers. Counters are derived from the event
+ *      stream, the state and device busy counts are read from
+ *      ProcessState.c and Device.c when an event is published.
+ */
+
+// Include guard
+#ifndef LIVESTATS_C
+#define LIVESTATS_C
+
+// Include header
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "LiveStats.h"
+#include "Device.h"
+#include "ProcessState.h"
+
+// What the live counters remember of a process
+struct LiveProcess
+{
+    long long memoryUsed;
+};
+
+// Writer state
+static struct LiveStats *liveStats = NULL;
+static char *liveStatsName = NULL;
+static struct LiveProcess *liveProcesses = NULL;
+static int liveProcessCapacity = 0;
+static long long liveAllocation = 0;
+static long long windowStart = 0;
+static long long windowEvents = 0;
+
+static long long monotonicUsec( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+static struct LiveProcess *liveProcess( int processId )
+{
+    /**
+     * Desc:
+     *      Find the counters of a process, growing the table as needed.
+     *
+     * Args:
+     *      processId (int): processCounter of the process
+     *
+     * Returns:
+     *      The process counters.
+     */
+    if( ( processId ) >= ( liveProcessCapacity ) )
+    {
+        int capacity = liveProcessCapacity > 0 ? liveProcessCapacity : 64;
+
+        while( ( capacity ) <= ( processId ) )
+        {
+            capacity *= 2;
+        }
+
+        liveProcesses = realloc( liveProcesses,
+                                 sizeof( struct LiveProcess ) * capacity );
+        for( int index = liveProcessCapacity; ( index ) < ( capacity );
+             index++ )
+        {
+            liveProcesses[index].memoryUsed = 0;
+        }
+
+        liveProcessCapacity = capacity;
+    }
+
+    return &liveProcesses[processId];
+}
+
+static void liveStateChange( int processId, int state )
+{
+    /**
+     * Desc:
+     *      Follow the process on the CPU. An exiting process gives its
+     *      memory back.
+     *
+     * Args:
+     *      processId (int): processCounter of the process
+     *      state (int): PROCESS_STATES value it moves to
+     */
+    struct LiveProcess *process = liveProcess( processId );
+
+    if( ( state ) == ( STATE_RUNNING ) )
+    {
+        liveStats->runningProcess = processId;
+    }
+    else if( ( liveStats->runningProcess ) == ( processId ) )
+    {
+        liveStats->runningProcess = -1;
+    }
+
+    if( ( state ) == ( STATE_EXIT ) )
+    {
+        liveStats->memoryUsed -= process->memoryUsed;
+        process->memoryUsed = 0;
+    }
+}
+
+static void liveReset( void )
+{
+    // A new simulation starts, as a daemon does for every client
+    for( int index = 0; ( index ) < ( liveProcessCapacity ); index++ )
+    {
+        liveProcesses[index].memoryUsed = 0;
+    }
+
+    liveStats->runningProcess = -1;
+    liveStats->memoryUsed = 0;
+    liveStats->opsCompleted = 0;
+}
+
+// Begin implementation
+int liveStatsOpen( char *name, CfgData *data )
+{
+    /**
+     * Desc:
+     *      Create the shared memory segment and start publishing.
+     *
+     * Args:
+     *      name (char*): segment name, e.g. "/sim04"
+     *      data (CfgData*): config holding the memory and channel counts
+     *
+     * Returns:
+     *      1 if the segment was created, otherwise 0.
+     */
+    int segment = shm_open( name, O_CREAT | O_RDWR, 0644 );
+
+    if( ( segment ) < ( 0 ) )
+    {
+        return 0;
+    }
+
+    if( ( ftruncate( segment, sizeof( struct LiveStats ) ) ) != ( 0 ) )
+    {
+        close( segment );
+        shm_unlink( name );
+        return 0;
+    }
+
+    liveStats = mmap( NULL, sizeof( struct LiveStats ),
+                      PROT_READ | PROT_WRITE, MAP_SHARED, segment, 0 );
+    close( segment );
+
+    if( ( liveStats ) == ( MAP_FAILED ) )
+    {
+        liveStats = NULL;
+        shm_unlink( name );
+        return 0;
+    }
+
+    liveStatsName = malloc( strlen( name ) + 1 );
+    strcpy( liveStatsName, name );
+
+    // Readers check the magic and version last, once the rest is valid
+    memset( liveStats, 0, sizeof( struct LiveStats ) );
+    liveStats->running = 1;
+    liveStats->pid = getpid();
+    liveStats->runningProcess = -1;
+    liveStats->startedAt = monotonicUsec();
+    liveStats->updatedAt = liveStats->startedAt;
+    liveStats->memoryAvailable = data->memAvailable;
+
+    for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+    {
+        liveStats->deviceChannels[device] = data->deviceChannels[device];
+    }
+
+    windowStart = liveStats->startedAt;
+    windowEvents = 0;
+    __atomic_store_n( &liveStats->version, LIVE_STATS_VERSION,
+                      __ATOMIC_RELAXED );
+    __atomic_store_n( &liveStats->magic, LIVE_STATS_MAGIC, __ATOMIC_RELEASE );
+    return 1;
+}
+
+void liveStatsRecord( const struct SimEvent *event, long long now )
+{
+    /**
+     * Desc:
+     *      Count a logged event and publish the counters.
+     *
+     * Args:
+     *      event (const struct SimEvent*): event being logged
+     *      now (long long): simulated time of the event in usec
+     */
+    long long wallTime;
+
+    if( ( liveStats ) == ( NULL ) )
+    {
+        return;
+    }
+
+    wallTime = monotonicUsec();
+
+    // Odd sequence, readers retry until the update is done
+    __atomic_store_n( &liveStats->sequence, liveStats->sequence + 1,
+                      __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+
+    switch( event->type )
+    {
+        case EVENT_SYSTEM_START:
+            liveReset();
+            break;
+
+        case EVENT_PROCESS_STATE:
+            liveStateChange( event->processId, (int) event->value );
+            break;
+
+        case EVENT_MMU_START:
+            liveAllocation = event->opIndex == OP_ALLOCATE ?
+                             event->value % 1000 : 0;
+            break;
+
+        case EVENT_MMU_RESULT:
+            liveStats->opsCompleted++;
+            if( ( event->value ) == ( 1 ) && ( liveAllocation ) > ( 0 ) )
+            {
+                liveProcess( event->processId )->memoryUsed += liveAllocation;
+                liveStats->memoryUsed += liveAllocation;
+            }
+            liveAllocation = 0;
+            break;
+
+        case EVENT_OP_END:
+            liveStats->opsCompleted++;
+            break;
+    }
+
+    for( int state = 0; ( state ) < ( STATE_COUNT ); state++ )
+    {
+        liveStats->stateCounts[state] = processStateCount( state );
+    }
+
+    for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+    {
+        liveStats->deviceBusy[device] = deviceBusyChannels( device );
+    }
+
+    liveStats->eventCount++;
+    liveStats->simulatedTime = now;
+    liveStats->updatedAt = wallTime;
+
+    if( ( wallTime - windowStart ) >= ( 1000000 ) )
+    {
+        liveStats->eventsPerSecond = ( liveStats->eventCount - windowEvents ) *
+                                     1000000.0 / ( wallTime - windowStart );
+        windowStart = wallTime;
+        windowEvents = liveStats->eventCount;
+    }
+
+    __atomic_store_n( &liveStats->sequence, liveStats->sequence + 1,
+                      __ATOMIC_RELEASE );
+}
+
+void liveStatsClose( void )
+{
+    /**
+     * Desc:
+     *      Mark the run finished and remove the segment. Attached readers
+     *      keep their mapping and see the final counters.
+     */
+    if( ( liveStats ) == ( NULL ) )
+    {
+        return;
+    }
+
+    __atomic_store_n( &liveStats->sequence, liveStats->sequence + 1,
+                      __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    liveStats->running = 0;
+    liveStats->updatedAt = monotonicUsec();
+    __atomic_store_n( &liveStats->sequence, liveStats->sequence + 1,
+                      __ATOMIC_RELEASE );
+
+    munmap( liveStats, sizeof( struct LiveStats ) );
+    shm_unlink( liveStatsName );
+    free( liveStatsName );
+    free( liveProcesses );
+    liveStats = NULL;
+    liveStatsName = NULL;
+    liveProcesses = NULL;
+    liveProcessCapacity = 0;
+}
+
+const struct LiveStats *liveStatsAttach( char *name )
+{
+    /**
+     * Desc:
+     *      Map the segment of a running simulation read only.
+     *
+     * Args:
+     *      name (char*): segment name the simulation was started with
+     *
+     * Returns:
+     *      The segment, or NULL if it doesn't exist or has another layout.
+     */
+    int segment = shm_open( name, O_RDONLY, 0 );
+    const struct LiveStats *shared;
+
+    if( ( segment ) < ( 0 ) )
+    {
+        return NULL;
+    }
+
+    shared = mmap( NULL, sizeof( struct LiveStats ), PROT_READ, MAP_SHARED,
+                   segment, 0 );
+    close( segment );
+
+    if( ( shared ) == ( MAP_FAILED ) )
+    {
+        return NULL;
+    }
+
+    if( ( __atomic_load_n( &shared->magic, __ATOMIC_ACQUIRE ) ) !=
+        ( LIVE_STATS_MAGIC ) || ( shared->version ) != ( LIVE_STATS_VERSION ) )
+    {
+        liveStatsDetach( shared );
+        return NULL;
+    }
+
+    return shared;
+}
+
+int liveStatsRead( const struct LiveStats *shared, struct LiveStats *snapshot )
+{
+    /**
+     * Desc:
+     *      Copy a consistent snapshot of the counters.
+     *
+     * Args:
+     *      shared (const struct LiveStats*): attached segment
+     *      snapshot (struct LiveStats*): receives the counters
+     *
+     * Returns:
+     *      1 while the simulation is running, 0 once it finished.
+     */
+    unsigned int before;
+    unsigned int after;
+
+    do
+    {
+        before = __atomic_load_n( &shared->sequence, __ATOMIC_ACQUIRE );
+        memcpy( snapshot, (const void *) shared, sizeof( struct LiveStats ) );
+        __atomic_thread_fence( __ATOMIC_ACQUIRE );
+        after = __atomic_load_n( &shared->sequence, __ATOMIC_RELAXED );
+    } while( ( before & 1 ) == ( 1 ) || ( before ) != ( after ) );
+
+    return snapshot->running;
+}
+
+void liveStatsDetach( const struct LiveStats *shared )
+{
+    /**
+     * Desc:
+     *      Unmap a segment mapped by liveStatsAttach.
+     *
+     * Args:
+     *      shared (const struct LiveStats*): attached segment
+     */
+    munmap( (void *) shared, sizeof( struct LiveStats ) );
+}
+
+// End include guard
+#endif              // LIVESTATS_C
@@ -0,0 +1,66 @@
+/**
+ * Name:
+ *      LiveStats.h
+ *
+ * Desc:
+ *      Live counters published in a POSIX shared memory segment, so a
+ *      running simulation can be watched with sim04top. The simulator
+ *      updates the segment as it logs events, readers take consistent
+ *      snapshots through a sequence lock.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef LIVESTATS_H
+#define LIVESTATS_H
+
+// Segment identification, the version changes with the struct layout
+#define LIVE_STATS_MAGIC    0x34304D53
+#define LIVE_STATS_VERSION  1
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+#include "SimEvent.h"
+
+// Shared segment layout
+//      sequence is odd while the simulator is writing. Times are usec,
+//      updatedAt and startedAt are CLOCK_MONOTONIC so readers on the same
+//      machine can tell how stale the segment is. eventsPerSecond is the
+//      wall clock rate over the last second or more. Memory is the KB
+//      allocated by live processes, which can exceed the memory available
+//      when swapping.
+struct LiveStats
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int sequence;
+    int running;
+    int pid;
+    int runningProcess;
+    long long startedAt;
+    long long updatedAt;
+    long long simulatedTime;
+    long long eventCount;
+    long long opsCompleted;
+    double eventsPerSecond;
+    int stateCounts[STATE_COUNT];
+    int deviceBusy[DEVICE_COUNT];
+    int deviceChannels[DEVICE_COUNT];
+    long long memoryUsed;
+    long long memoryAvailable;
+};
+
+// Function headers
+int liveStatsOpen( char *name, CfgData *data );
+void liveStatsRecord( const struct SimEvent *event, long long now );
+void liveStatsClose( void );
+const struct LiveStats *liveStatsAttach( char *name );
+int liveStatsRead( const struct LiveStats *shared, struct LiveStats *snapshot );
+void liveStatsDetach( const struct LiveStats *shared );
+
+// End include guard
+#endif              // LIVESTATS_H
@@ -0,0 +1,728 @@
+/**
+ * Name:
+ *      LogSink.c
+ *
+ * Desc:
+ *      Implementation of LogSink.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Only the text format goes through sprintf. The other writers build
+ *      their records by hand and keep time as integer microseconds, so no
+ *      doubles are formatted on the hot path.
+ *
+ *      The log is the only part of a run that never feeds back into the
+ *      simulation, so it is the part handed to other threads. The CPU,
+ *      scheduler and devices stay on the simulation thread, the event
+ *      engine itself is sequential. The threads pay off when the log goes
+ *      to a file, monitor output is mostly bound by writing it.
+ */
+
+// Include guard
+#ifndef LOGSINK_C
+#define LOGSINK_C
+
+// Include header
+#include "LogSink.h"
+#include "Profiler.h"
+
+const char *LOG_FORMAT_NAMES[] = {"Text", "CSV", "JSONL", "Binary"};
+
+// Where the monitor log goes, stdout unless set
+static FILE *monitorStream = NULL;
+
+// Event waiting in a window for the log threads
+struct PendingEvent
+{
+    struct SimEvent event;
+    double time;
+};
+
+// Part of a window formatted by one log thread
+//      monitor and file receive the records of the two outputs. file is
+//      NULL when both outputs share a format and the monitor records are
+//      written to the file too.
+struct LogSlice
+{
+    const struct PendingEvent *events;
+    int count;
+    CfgData *data;
+    char *monitor;
+    size_t monitorLength;
+    char *file;
+    size_t fileLength;
+};
+
+// Window of events, filled by the simulation then formatted by the log
+// threads. busy is 1 while the threads work on it.
+struct LogWindow
+{
+    struct PendingEvent *events;
+    int count;
+    struct LogSlice *slices;
+    int busy;
+};
+
+// Log thread state, see LogSink.h. windows are double buffered, filling
+// is the one taking events. The run's config and log file are kept from
+// logSinkStart.
+static int logThreads = 0;
+static int windowsStarted = 0;
+static struct LogWindow windows[2];
+static int filling = 0;
+static CfgData *windowData = NULL;
+static struct LogFile *windowLogFile = NULL;
+
+// Log thread pool, started with the windows and kept for the whole run
+//      Each window handed to the pool bumps poolGeneration, every thread
+//      formats its slice of poolWindow and the last one to finish signals
+//      poolDone.
+static pthread_t poolThreads[LOG_MAX_THREADS];
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t poolWork = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t poolDone = PTHREAD_COND_INITIALIZER;
+static struct LogWindow *poolWindow = NULL;
+static long long poolGeneration = 0;
+static int poolPending = 0;
+static int poolStop = 0;
+
+static const char *CSV_HEADER =
+    "time_us,event,process,component,op,value,value2\n";
+
+static size_t writeDecimal( char *out, long long value )
+{
+    /**
+     * Desc:
+     *      Write an integer in decimal.
+     *
+     * Args:
+     *      out (char*): output, needs room for 20 chars
+     *      value (long long): value to write
+     *
+     * Returns:
+     *      The number of chars written, no terminator is added.
+     */
+    char digits[20];
+    unsigned long long magnitude = value;
+    size_t length = 0;
+    size_t count = 0;
+
+    if( ( value ) < ( 0 ) )
+    {
+        out[length++] = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    do
+    {
+        digits[count++] = (char) ( '0' + magnitude % 10 );
+        magnitude /= 10;
+    } while( ( magnitude ) != ( 0 ) );
+
+    while( ( count ) > ( 0 ) )
+    {
+        out[length++] = digits[--count];
+    }
+
+    return length;
+}
+
+static size_t writeString( char *out, const char *str )
+{
+    size_t length = 0;
+
+    while( ( str[length] ) != ( '\0' ) )
+    {
+        out[length] = str[length];
+        length++;
+    }
+
+    return length;
+}
+
+static size_t writeCsv( const struct SimEvent *event, long long timeUSec,
+                        char *out )
+{
+    size_t length = writeDecimal( out, timeUSec );
+
+    out[length++] = ',';
+    length += writeString( out + length, EVENT_TYPE_NAMES[event->type] );
+    out[length++] = ',';
+    length += writeDecimal( out + length, event->processId );
+    out[length++] = ',';
+    if( ( event->component ) != ( 0 ) )
+    {
+        out[length++] = event->component;
+    }
+    out[length++] = ',';
+    if( ( event->opIndex ) >= ( 0 ) )
+    {
+        length += writeString( out + length,
+                               META_LEGAL_OP_STRINGS[event->opIndex] );
+    }
+    out[length++] = ',';
+    length += writeDecimal( out + length, event->value );
+    out[length++] = ',';
+    length += writeDecimal( out + length, event->value2 );
+    out[length++] = '\n';
+
+    return length;
+}
+
+static size_t writeJsonLine( const struct SimEvent *event, long long timeUSec,
+                             char *out )
+{
+    size_t length = writeString( out, "{\"time_us\":" );
+
+    length += writeDecimal( out + length, timeUSec );
+    length += writeString( out + length, ",\"event\":\"" );
+    length += writeString( out + length, EVENT_TYPE_NAMES[event->type] );
+    length += writeString( out + length, "\",\"process\":" );
+    length += writeDecimal( out + length, event->processId );
+
+    // Component and op only exist on process op events
+    if( ( event->component ) != ( 0 ) )
+    {
+        length += writeString( out + length, ",\"component\":\"" );
+        out[length++] = event->component;
+        out[length++] = '"';
+    }
+
+    if( ( event->opIndex ) >= ( 0 ) )
+    {
+        length += writeString( out + length, ",\"op\":\"" );
+        length += writeString( out + length,
+                               META_LEGAL_OP_STRINGS[event->opIndex] );
+        out[length++] = '"';
+    }
+
+    length += writeString( out + length, ",\"value\":" );
+    length += writeDecimal( out + length, event->value );
+    length += writeString( out + length, ",\"value2\":" );
+    length += writeDecimal( out + length, event->value2 );
+    length += writeString( out + length, "}\n" );
+
+    return length;
+}
+
+static size_t writeBinary( const struct SimEvent *event, long long timeUSec,
+                           char *out )
+{
+    uint32_t recordSize = LOG_BINARY_RECORD_SIZE;
+    int64_t time = timeUSec;
+    int32_t type = event->type;
+    int32_t processId = event->processId;
+    int32_t opIndex = event->opIndex;
+    int64_t value = event->value;
+    int64_t value2 = event->value2;
+    size_t length = 0;
+
+    memcpy( out + length, &recordSize, sizeof( recordSize ) );
+    length += sizeof( recordSize );
+    memcpy( out + length, &time, sizeof( time ) );
+    length += sizeof( time );
+    memcpy( out + length, &type, sizeof( type ) );
+    length += sizeof( type );
+    memcpy( out + length, &processId, sizeof( processId ) );
+    length += sizeof( processId );
+    memcpy( out + length, &opIndex, sizeof( opIndex ) );
+    length += sizeof( opIndex );
+    memcpy( out + length, &value, sizeof( value ) );
+    length += sizeof( value );
+    memcpy( out + length, &value2, sizeof( value2 ) );
+    length += sizeof( value2 );
+    out[length++] = event->component;
+
+    return length;
+}
+
+static size_t writeHeader( int format, char *out )
+{
+    uint32_t version = LOG_BINARY_VERSION;
+
+    switch( format )
+    {
+        case LOG_FORMAT_CSV:
+            return writeString( out, CSV_HEADER );
+
+        case LOG_FORMAT_BINARY:
+            memcpy( out, LOG_BINARY_MAGIC, 4 );
+            memcpy( out + 4, &version, sizeof( version ) );
+            return 4 + sizeof( version );
+    }
+
+    return 0;
+}
+
+static size_t writeEvent( int format, const struct SimEvent *event,
+                          CfgData *data, double time, char *out )
+{
+    long long timeUSec = (long long) ( time * 1000000.0 + 0.5 );
+
+    switch( format )
+    {
+        case LOG_FORMAT_CSV:
+            return writeCsv( event, timeUSec, out );
+
+        case LOG_FORMAT_JSONL:
+            return writeJsonLine( event, timeUSec, out );
+
+        case LOG_FORMAT_BINARY:
+            return writeBinary( event, timeUSec, out );
+    }
+
+    formatEvent( event, data, time, out );
+    return strlen( out );
+}
+
+static void *formatSlice( void *slicePointer )
+{
+    /**
+     * Desc:
+     *      Format the events of a slice into its output buffers. Runs on a
+     *      log thread.
+     *
+     * Args:
+     *      slicePointer (void*): struct LogSlice to format
+     *
+     * Returns:
+     *      slicePointer.
+     */
+    struct LogSlice *slice = slicePointer;
+    CfgData *data = slice->data;
+
+    slice->monitorLength = 0;
+    slice->fileLength = 0;
+
+    for( int index = 0; ( index ) < ( slice->count ); index++ )
+    {
+        const struct PendingEvent *pending = &slice->events[index];
+
+        if( ( slice->monitor ) != ( NULL ) )
+        {
+            slice->monitorLength += writeEvent( data->monitorFormat,
+                &pending->event, data, pending->time,
+                slice->monitor + slice->monitorLength );
+        }
+
+        if( ( slice->file ) != ( NULL ) )
+        {
+            slice->fileLength += writeEvent( data->fileFormat,
+                &pending->event, data, pending->time,
+                slice->file + slice->fileLength );
+        }
+    }
+
+    return slicePointer;
+}
+
+static void *logThread( void *threadPointer )
+{
+    /**
+     * Desc:
+     *      Body of a pool thread. Formats its slice of every window handed
+     *      to the pool until the pool stops.
+     *
+     * Args:
+     *      threadPointer (void*): index of the thread, cast from intptr_t
+     *
+     * Returns:
+     *      NULL.
+     */
+    int thread = (int) (intptr_t) threadPointer;
+    long long seen = 0;
+
+    pthread_mutex_lock( &poolLock );
+    while( 1 )
+    {
+        while( ( poolGeneration ) == ( seen ) && ( poolStop ) == ( 0 ) )
+        {
+            pthread_cond_wait( &poolWork, &poolLock );
+        }
+
+        if( ( poolStop ) == ( 1 ) )
+        {
+            break;
+        }
+
+        struct LogWindow *window = poolWindow;
+        seen = poolGeneration;
+        pthread_mutex_unlock( &poolLock );
+
+        formatSlice( &window->slices[thread] );
+
+        pthread_mutex_lock( &poolLock );
+        if( ( --poolPending ) == ( 0 ) )
+        {
+            pthread_cond_signal( &poolDone );
+        }
+    }
+    pthread_mutex_unlock( &poolLock );
+
+    return NULL;
+}
+
+static void finishWindow( struct LogWindow *window )
+{
+    /**
+     * Desc:
+     *      Wait for the log threads of a window and write its records in
+     *      event order.
+     *
+     * Args:
+     *      window (struct LogWindow*): window being formatted, or idle
+     */
+    if( ( window->busy ) == ( 0 ) )
+    {
+        return;
+    }
+
+    PROFILE_ENTER( PROFILE_LOG_FORMAT );
+    pthread_mutex_lock( &poolLock );
+    while( ( poolPending ) > ( 0 ) )
+    {
+        pthread_cond_wait( &poolDone, &poolLock );
+    }
+    pthread_mutex_unlock( &poolLock );
+    PROFILE_LEAVE( PROFILE_LOG_FORMAT );
+
+    PROFILE_ENTER( PROFILE_LOG_APPEND );
+    for( int thread = 0; ( thread ) < ( logThreads ); thread++ )
+    {
+        struct LogSlice *slice = &window->slices[thread];
+
+        if( ( windowData->logTo ) != ( 1 ) && ( slice->monitorLength ) > ( 0 ) )
+        {
+            fwrite( slice->monitor, 1, slice->monitorLength,
+                    monitorStream != NULL ? monitorStream : stdout );
+        }
+
+        if( ( windowData->logTo ) != ( 0 ) )
+        {
+            const char *records = slice->file != NULL ? slice->file
+                                                      : slice->monitor;
+            size_t length = slice->file != NULL ? slice->fileLength
+                                                : slice->monitorLength;
+
+            if( ( length ) > ( 0 ) )
+            {
+                logFileAppend( windowLogFile, records, length );
+            }
+        }
+    }
+    PROFILE_LEAVE( PROFILE_LOG_APPEND );
+
+    window->busy = 0;
+    window->count = 0;
+}
+
+static void startWindow( struct LogWindow *window )
+{
+    /**
+     * Desc:
+     *      Split a window into one slice per log thread and hand it to
+     *      the pool. The pool must be idle.
+     *
+     * Args:
+     *      window (struct LogWindow*): window holding at least one event
+     */
+    int first = 0;
+
+    for( int thread = 0; ( thread ) < ( logThreads ); thread++ )
+    {
+        struct LogSlice *slice = &window->slices[thread];
+        int last = (int) ( (long long) window->count * ( thread + 1 ) /
+                           logThreads );
+
+        slice->events = window->events + first;
+        slice->count = last - first;
+        first = last;
+    }
+
+    pthread_mutex_lock( &poolLock );
+    poolWindow = window;
+    poolPending = logThreads;
+    poolGeneration++;
+    pthread_cond_broadcast( &poolWork );
+    pthread_mutex_unlock( &poolLock );
+
+    window->busy = 1;
+}
+
+static void freeWindows( void )
+{
+    /**
+     * Desc:
+     *      Stop the pool threads and free both windows. The windows must
+     *      be idle.
+     */
+    if( ( windowsStarted ) == ( 0 ) )
+    {
+        return;
+    }
+
+    pthread_mutex_lock( &poolLock );
+    poolStop = 1;
+    pthread_cond_broadcast( &poolWork );
+    pthread_mutex_unlock( &poolLock );
+
+    for( int thread = 0; ( thread ) < ( logThreads ); thread++ )
+    {
+        pthread_join( poolThreads[thread], NULL );
+    }
+
+    for( int index = 0; ( index ) < ( 2 ); index++ )
+    {
+        struct LogWindow *window = &windows[index];
+
+        for( int thread = 0; ( thread ) < ( logThreads ); thread++ )
+        {
+            free( window->slices[thread].monitor );
+            free( window->slices[thread].file );
+        }
+
+        free( window->events );
+        free( window->slices );
+    }
+
+    windowsStarted = 0;
+}
+
+static void startWindows( CfgData *data, struct LogFile *logFile )
+{
+    /**
+     * Desc:
+     *      Set up both windows and the slice buffers for a run and start
+     *      the pool threads, dropping any left from an earlier run.
+     *
+     * Args:
+     *      data (CfgData*): config holding the log mode and formats
+     *      logFile (struct LogFile*): log file being built
+     */
+    int sliceEvents = ( LOG_WINDOW_EVENTS + logThreads - 1 ) / logThreads;
+    int monitor = data->logTo != 1;
+    int file = data->logTo == 1 ||
+               ( data->logTo == 2 && data->fileFormat != data->monitorFormat );
+
+    freeWindows();
+
+    for( int index = 0; ( index ) < ( 2 ); index++ )
+    {
+        struct LogWindow *window = &windows[index];
+
+        window->events = malloc( sizeof( struct PendingEvent ) *
+                                 LOG_WINDOW_EVENTS );
+        window->slices = malloc( sizeof( struct LogSlice ) * logThreads );
+        window->count = 0;
+        window->busy = 0;
+
+        for( int thread = 0; ( thread ) < ( logThreads ); thread++ )
+        {
+            struct LogSlice *slice = &window->slices[thread];
+
+            slice->data = data;
+            slice->monitor = monitor ? malloc( (size_t) sliceEvents *
+                                               LOG_MAX_RECORD ) : NULL;
+            slice->file = file ? malloc( (size_t) sliceEvents *
+                                         LOG_MAX_RECORD ) : NULL;
+            slice->monitorLength = 0;
+            slice->fileLength = 0;
+        }
+    }
+
+    filling = 0;
+    windowData = data;
+    windowLogFile = logFile;
+    windowsStarted = 1;
+
+    poolWindow = NULL;
+    poolGeneration = 0;
+    poolPending = 0;
+    poolStop = 0;
+    for( int thread = 0; ( thread ) < ( logThreads ); thread++ )
+    {
+        pthread_create( &poolThreads[thread], NULL, logThread,
+                        (void *) (intptr_t) thread );
+    }
+}
+
+// Begin implementation
+int logFormatCode( const char *name )
+{
+    /**
+     * Desc:
+     *      Look up a log format by its config name.
+     *
+     * Args:
+     *      name (const char*): format name, e.g. "CSV"
+     *
+     * Returns:
+     *      The LOG_FORMATS code, or -1 if the name is not a format.
+     */
+    for( int format = 0; ( format ) < ( LOG_FORMAT_COUNT ); format++ )
+    {
+        if( ( compareString( name, LOG_FORMAT_NAMES[format] ) ) == ( 1 ) )
+        {
+            return format;
+        }
+    }
+
+    return -1;
+}
+
+void logSinkSetMonitor( FILE *stream )
+{
+    /**
+     * Desc:
+     *      Send the monitor log somewhere other than stdout.
+     *
+     * Args:
+     *      stream (FILE*): stream to write to, NULL for stdout
+     */
+    monitorStream = stream;
+}
+
+void logSinkStart( CfgData *data, struct LogFile *logFile )
+{
+    /**
+     * Desc:
+     *      Write the header of each log that needs one, before any event.
+     *
+     * Args:
+     *      data (CfgData*): config holding the log mode and formats
+     *      logFile (struct LogFile*): log file being built
+     */
+    char header[64];
+    size_t length;
+
+    if( ( logThreads ) > ( 0 ) )
+    {
+        startWindows( data, logFile );
+    }
+
+    if( ( data->logTo ) != ( 1 ) )
+    {
+        length = writeHeader( data->monitorFormat, header );
+        fwrite( header, 1, length, monitorStream != NULL ? monitorStream
+                                                         : stdout );
+    }
+
+    if( ( data->logTo ) != ( 0 ) )
+    {
+        length = writeHeader( data->fileFormat, header );
+        if( ( length ) > ( 0 ) )
+        {
+            logFileAppend( logFile, header, length );
+        }
+    }
+}
+
+void logSinkWrite( const struct SimEvent *event, CfgData *data, double time,
+                   struct LogFile *logFile, char *logLine )
+{
+    /**
+     * Desc:
+     *      Write an event to the monitor and/or the log file, depending on
+     *      the log mode, each in its own format.
+     *
+     * Args:
+     *      event (const struct SimEvent*): event to write
+     *      data (CfgData*): config holding the log mode and formats
+     *      time (double): timestamp of the event in seconds
+     *      logFile (struct LogFile*): log file being built
+     *      logLine (char*): scratch buffer, at least BUFFER_SIZE chars
+     */
+    size_t length = 0;
+
+    // Queue the event, a full window goes to the log threads while the
+    // other one fills
+    if( ( windowsStarted ) == ( 1 ) )
+    {
+        struct LogWindow *window = &windows[filling];
+
+        window->events[window->count].event = *event;
+        window->events[window->count].time = time;
+        window->count++;
+
+        if( ( window->count ) == ( LOG_WINDOW_EVENTS ) )
+        {
+            finishWindow( &windows[1 - filling] );
+            startWindow( window );
+            filling = 1 - filling;
+        }
+        return;
+    }
+
+    if( ( data->logTo ) != ( 1 ) )
+    {
+        PROFILE_ENTER( PROFILE_LOG_FORMAT );
+        length = writeEvent( data->monitorFormat, event, data, time, logLine );
+        PROFILE_LEAVE( PROFILE_LOG_FORMAT );
+        PROFILE_ENTER( PROFILE_LOG_APPEND );
+        fwrite( logLine, 1, length, monitorStream != NULL ? monitorStream
+                                                          : stdout );
+        PROFILE_LEAVE( PROFILE_LOG_APPEND );
+    }
+
+    if( ( data->logTo ) != ( 0 ) )
+    {
+        // Both outputs usually share a format, so reuse the record
+        if( ( data->logTo ) != ( 2 ) ||
+            ( data->fileFormat ) != ( data->monitorFormat ) )
+        {
+            PROFILE_ENTER( PROFILE_LOG_FORMAT );
+            length = writeEvent( data->fileFormat, event, data, time, logLine );
+            PROFILE_LEAVE( PROFILE_LOG_FORMAT );
+        }
+
+        PROFILE_ENTER( PROFILE_LOG_APPEND );
+        logFileAppend( logFile, logLine, length );
+        PROFILE_LEAVE( PROFILE_LOG_APPEND );
+    }
+}
+
+void setLogThreads( int threads )
+{
+    /**
+     * Desc:
+     *      Set the number of threads formatting the log, from the next
+     *      logSinkStart on. Only call it between runs. Counts above
+     *      LOG_MAX_THREADS are clamped to it.
+     *
+     * Args:
+     *      threads (int): thread count, 0 to format every event inline
+     */
+    logThreads = threads > 0 ? threads : 0;
+    if( ( logThreads ) > ( LOG_MAX_THREADS ) )
+    {
+        logThreads = LOG_MAX_THREADS;
+    }
+}
+
+void logSinkFlush( void )
+{
+    /**
+     * Desc:
+     *      Write every event still waiting for the log threads, in order,
+     *      and free the windows. Must be called at the end of a run that
+     *      was started with log threads on.
+     */
+    if( ( windowsStarted ) == ( 0 ) )
+    {
+        return;
+    }
+
+    finishWindow( &windows[1 - filling] );
+    if( ( windows[filling].count ) > ( 0 ) )
+    {
+        startWindow( &windows[filling] );
+        finishWindow( &windows[filling] );
+    }
+
+    freeWindows();
+}
+
+// End include guard
+#endif              // LOGSINK_C
@@ -0,0 +1,67 @@
+/**
+ * Name:
+ *      LogSink.h
+ *
+ * Desc:
+ *      Log output formats. Every event is written to the monitor and to the
+ *      log file in the format picked for each in the config, either the
+ *      human readable text, CSV, JSON Lines or a compact binary record.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef LOGSINK_H
+#define LOGSINK_H
+
+// Log format codes, index into LOG_FORMAT_NAMES
+enum LOG_FORMATS { LOG_FORMAT_TEXT, LOG_FORMAT_CSV, LOG_FORMAT_JSONL,
+                   LOG_FORMAT_BINARY, LOG_FORMAT_COUNT };
+
+// Binary log layout
+//      The log starts with the 4 magic bytes and a 32 bit version. Every
+//      event is then a 32 bit length followed by that many bytes:
+//          int64 time (usec), int32 type, int32 processId, int32 opIndex,
+//          int64 value, int64 value2, char component
+//      All fields are in host byte order. Readers should skip any bytes
+//      past the fields they know, later versions only append fields.
+#define LOG_BINARY_MAGIC        "S4EV"
+#define LOG_BINARY_VERSION      1
+#define LOG_BINARY_RECORD_SIZE  37
+
+// Threaded output
+//      With log threads on, events are buffered in windows of
+//      LOG_WINDOW_EVENTS. A full window is formatted by the log threads
+//      while the simulation fills the next one, and the records are written
+//      in event order, so the output is the same as formatting inline.
+//      LOG_MAX_RECORD is the most any format writes for one event. The
+//      threads are started once per run, at most LOG_MAX_THREADS of them.
+//      Windows hold the monitor output back, so they are only used with
+//      the virtual timer.
+#define LOG_WINDOW_EVENTS       8192
+#define LOG_MAX_RECORD          256
+#define LOG_MAX_THREADS         64
+
+// Include header
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "InputDataProcessor.h"
+#include "LinkedList.h"
+#include "SimEvent.h"
+
+extern const char *LOG_FORMAT_NAMES[];
+
+// Function headers
+int logFormatCode( const char *name );
+void logSinkSetMonitor( FILE *stream );
+void logSinkStart( CfgData *data, struct LogFile *logFile );
+void logSinkWrite( const struct SimEvent *event, CfgData *data, double time,
+                   struct LogFile *logFile, char *logLine );
+void setLogThreads( int threads );
+void logSinkFlush( void );
+
+// End include guard
+#endif              // LOGSINK_H
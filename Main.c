@@ -3,20 +3,133 @@
 #include "LinkedList.h"
 #include "ProcessPcb.h"
 #include "simtimer.h"
+#include "EventTrace.h"
+#include "Profiler.h"
+#include "Daemon.h"
 
-// Constants to define schedule and log modes in the config
-const char *CONFIG_SCHED_MODES[] = {"FCFS-N", "SJF-N", "SRTF-P",
-                                    "FCFS-P", "RR-P"};
+// Constants to define log modes in the config
 const char *CONFIG_LOG_MODES[] = {"MONITOR", "FILE", "BOTH"};
 
 int main(int argc, char **argv) {
+    char *tracePath = NULL;
+    char *replayPath = NULL;
+    char *chromePath = NULL;
+    char *daemonPath = NULL;
+    char *livePath = NULL;
+    int printProfile = 0;
+    int printTimer = 0;
+    int printDevices = 0;
+    int printOps = 0;
+    int printCache = 0;
+    int printStates = 0;
+    int coalesce = 0;
+    int logThreads = 0;
+    int virtualTimer = 0;
+
+    profileStart();
+
     if( ( argc ) < ( 2 ) )
     {
         fprintf( stderr, "Must specify config file path\n" );
         return -1;
     }
 
+    // Parse the optional flags that follow the config file path
+    for( int argIndex = 2; ( argIndex ) < ( argc ); argIndex++ )
+    {
+        if( ( compareString( argv[argIndex], "--trace" ) ) == ( 1 ) &&
+            ( argIndex + 1 ) < ( argc ) )
+        {
+            tracePath = argv[++argIndex];
+        }
+        else if( ( compareString( argv[argIndex], "--replay" ) ) == ( 1 ) &&
+                 ( argIndex + 1 ) < ( argc ) )
+        {
+            replayPath = argv[++argIndex];
+        }
+        else if( ( compareString( argv[argIndex], "--chrome-trace" ) ) == ( 1 )
+                 && ( argIndex + 1 ) < ( argc ) )
+        {
+            chromePath = argv[++argIndex];
+        }
+        else if( ( compareString( argv[argIndex], "--daemon" ) ) == ( 1 ) &&
+                 ( argIndex + 1 ) < ( argc ) )
+        {
+            daemonPath = argv[++argIndex];
+        }
+        else if( ( compareString( argv[argIndex], "--live-stats" ) ) == ( 1 )
+                 && ( argIndex + 1 ) < ( argc ) )
+        {
+            livePath = argv[++argIndex];
+        }
+        else if( ( compareString( argv[argIndex], "--parse-threads" ) ) == ( 1 )
+                 && ( argIndex + 1 ) < ( argc ) )
+        {
+            setMetaParseThreads( stringToInt( argv[++argIndex] ) );
+        }
+        else if( ( compareString( argv[argIndex], "--log-threads" ) ) == ( 1 )
+                 && ( argIndex + 1 ) < ( argc ) )
+        {
+            // Formats the log on other threads, the simulation stays on one
+            logThreads = stringToInt( argv[++argIndex] );
+        }
+        else if( ( compareString( argv[argIndex], "--profile" ) ) == ( 1 ) )
+        {
+            printProfile = 1;
+        }
+        else if( ( compareString( argv[argIndex], "--timer-stats" ) ) == ( 1 ) )
+        {
+            printTimer = 1;
+        }
+        else if( ( compareString( argv[argIndex], "--device-stats" ) ) == ( 1 ) )
+        {
+            printDevices = 1;
+        }
+        else if( ( compareString( argv[argIndex], "--op-stats" ) ) == ( 1 ) )
+        {
+            printOps = 1;
+            opStatsEnable();
+        }
+        else if( ( compareString( argv[argIndex], "--cache-stats" ) ) == ( 1 ) )
+        {
+            printCache = 1;
+        }
+        else if( ( compareString( argv[argIndex], "--state-stats" ) ) == ( 1 ) )
+        {
+            printStates = 1;
+        }
+        else if( ( compareString( argv[argIndex], "--coalesce" ) ) == ( 1 ) )
+        {
+            coalesce = 1;
+        }
+        else if( ( compareString( argv[argIndex], "--verbose" ) ) == ( 1 ) )
+        {
+            // Fused ops still log every op from the file
+            coalesceSetVerbose( 1 );
+        }
+        else if( ( compareString( argv[argIndex], "--virtual" ) ) == ( 1 ) )
+        {
+            // Advance simulated time instead of waiting, for long horizons
+            setTimerMode( VIRTUAL_TIMER );
+            virtualTimer = 1;
+        }
+        else
+        {
+            fprintf( stderr, "Unknown option: %s\n", argv[argIndex] );
+            return -1;
+        }
+    }
+
+    // Log threads write a window at a time, too late for a real time run
+    if( ( logThreads ) > ( 0 ) && ( virtualTimer ) == ( 0 ) )
+    {
+        fprintf( stderr, "--log-threads needs --virtual\n" );
+        return -1;
+    }
+
+    PROFILE_ENTER( PROFILE_PARSE );
     CfgData *data =  processCFG( argv[1] );
+    PROFILE_LEAVE( PROFILE_PARSE );
 
     if( data == NULL )
     {
@@ -28,8 +141,8 @@ int main(int argc, char **argv) {
     printf("___________BEGIN CFG DUMP___________\n");
     printf("Version             : %d\n", data->version);
     printf("Meta Data File Path : %s\n", data->metaFilePath);
-    printf("CPU Scheduling Code : %s\n", CONFIG_SCHED_MODES[data->
-                                             cpuSchedulingCode]);
+    printf("CPU Scheduling Code : %s\n", schedulerName( data->
+                                             cpuSchedulingCode ));
     printf("Quantum Time Cycles : %d\n", data->quantumTimeCycles);
     printf("Memory Available    : %d\n", data->memAvailable);
     printf("Processor Cycle Time: %d\n", data->procCycleTime);
@@ -37,49 +150,171 @@ int main(int argc, char **argv) {
     printf("Logging             : %s\n", CONFIG_LOG_MODES[data->logTo]);
     printf("Log File Path       : %s\n\n", data->logPath);
 
-    struct LinkedList *meta = processMetaData( data->metaFilePath );
+    // Re-time a recorded trace instead of running the simulation
+    if( ( replayPath ) != ( NULL ) )
+    {
+        struct LogFile *logFile = replayTrace( replayPath, data );
+        int status = 0;
 
-    int arraySize = getNumStartSymbols( meta->next );
-    struct pcb *pcbArrayPointer = storePcb( meta, data );
-    struct LogFile *logFile = processPcbArray(  pcbArrayPointer, data, arraySize );
-    createLogFile( logFile, data->logPath );
-    deallocatePcb( pcbArrayPointer );
-    deallocateLogFile( logFile );
+        if( ( logFile ) == ( NULL ) )
+        {
+            fprintf( stderr, "There was an error replaying the trace file: %s\n",
+                     replayPath );
+            status = -1;
+        }
+        else
+        {
+            PROFILE_ENTER( PROFILE_LOG_FLUSH );
+            createLogFile( logFile, data->logPath );
+            PROFILE_LEAVE( PROFILE_LOG_FLUSH );
+            deallocateLogFile( logFile );
+        }
+
+        if( ( printProfile ) == ( 1 ) )
+        {
+            profilePrint();
+        }
+
+        free( data->metaFilePath );
+        free( data->logPath );
+        free( data );
+        return status;
+    }
+
+    if( ( livePath ) != ( NULL ) && ( liveStatsOpen( livePath, data ) ) == ( 0 ) )
+    {
+        fprintf( stderr, "Could not create the live stats segment: %s\n",
+                 livePath );
+    }
+
+    // Simulate jobs sent over a socket instead of the meta data file
+    if( ( daemonPath ) != ( NULL ) )
+    {
+        int status = runDaemon( data, daemonPath );
+
+        liveStatsClose();
+
+        if( ( status ) != ( 0 ) )
+        {
+            fprintf( stderr, "There was an error serving the socket: %s\n",
+                     daemonPath );
+        }
+
+        free( data->metaFilePath );
+        free( data->logPath );
+        free( data );
+        return status;
+    }
+
+    // Replays and daemon sessions always log inline
+    setLogThreads( logThreads );
+
+    PROFILE_ENTER( PROFILE_PARSE );
+    struct MetaData *meta = processMetaData( data->metaFilePath );
+    PROFILE_LEAVE( PROFILE_PARSE );
 
     if(meta == NULL)
     {
         fprintf(stderr, "There was an error parsing the meta data file: %s\n",
                 data->metaFilePath);
+        liveStatsClose();
         free(data->metaFilePath);
         free(data->logPath);
         free(data);
         return -1;
     }
 
-    struct LinkedList *currentNode = meta->next;
+    // Fuse adjacent ops, I/O only where the process keeps the CPU
+    if( ( coalesce ) == ( 1 ) )
+    {
+        PROFILE_ENTER( PROFILE_PARSE );
+        coalesceMetaData( meta, !schedulerFor( data->cpuSchedulingCode )->
+                                  preemptive );
+        PROFILE_LEAVE( PROFILE_PARSE );
+    }
+
+    if( ( tracePath ) != ( NULL ) && ( traceOpen( tracePath, data ) ) == ( 0 ) )
+    {
+        fprintf( stderr, "Could not create the trace file: %s\n", tracePath );
+    }
+
+    if( ( chromePath ) != ( NULL ) &&
+        ( chromeTraceOpen( chromePath, data ) ) == ( 0 ) )
+    {
+        fprintf( stderr, "Could not create the timeline file: %s\n",
+                 chromePath );
+    }
+
+    PROFILE_ENTER( PROFILE_PCB_BUILD );
+    int arraySize = meta->processCount;
+    struct pcb *pcbArrayPointer = storePcb( meta, data );
+    PROFILE_LEAVE( PROFILE_PCB_BUILD );
+    struct LogFile *logFile = processPcbArray(  pcbArrayPointer, data, arraySize );
+    traceClose();
+    chromeTraceClose();
+    liveStatsClose();
+    PROFILE_ENTER( PROFILE_LOG_FLUSH );
+    createLogFile( logFile, data->logPath );
+    PROFILE_LEAVE( PROFILE_LOG_FLUSH );
+    deallocatePcb( pcbArrayPointer, arraySize );
+    deallocateLogFile( logFile );
+
+    if( ( printProfile ) == ( 1 ) )
+    {
+        profilePrint();
+    }
+
+    if( ( printTimer ) == ( 1 ) )
+    {
+        printTimerStats();
+    }
+
+    if( ( printDevices ) == ( 1 ) )
+    {
+        devicesPrintStats( simulatedTime() );
+    }
+
+    if( ( printOps ) == ( 1 ) )
+    {
+        opStatsPrint();
+    }
 
-    //printf("___________BEGIN META DUMP___________\n");
-    while( currentNode != NULL )
+    if( ( printStates ) == ( 1 ) )
     {
-        /*printf( "The data item component letter is: %c\n",
-                *(char*) currentNode->data[0] );
-        printf( "The data item operation string is: %s\n",
-                (char*) currentNode->data[1] );
-        printf( "the data item cycle time is      : %d\n\n",
-                *(int*) currentNode->data[2] );*/
+        processStatesPrint();
+    }
 
-        struct LinkedList *toDelete = currentNode;
-        currentNode = currentNode->next;
+    opStatsFree();
 
-        // Free the node now that we don't need it anymore
-        free( toDelete->data[0] );
-        free( toDelete->data[1] );
-        free( toDelete->data[2] );
-        free( toDelete->data );
-        free( toDelete );
+    if( ( printCache ) == ( 1 ) )
+    {
+        cachePrintStats();
     }
 
-    free( meta );                 // Free the linked list head
+    cacheFree();
+
+    if( swapEnabled() )
+    {
+        swapPrintStats();
+    }
+
+    swapFree();
+
+    if( dispatchCostEnabled() )
+    {
+        dispatchCostPrintStats();
+    }
+
+    if( admissionEnabled() )
+    {
+        admissionPrintStats();
+    }
+
+    admissionFree();
+
+    devicesFree();
+
+    freeMetaData( meta );         // Free the meta data ops and index
     free( data->metaFilePath );   // Free the cfg meta file
     free( data->logPath );        // Free the log file path
     free( data );                 // Free the rest of the cfgData struct
@@ -0,0 +1,292 @@
+/**
+ * Name:
+ *      MetaScanner.c
+ *
+ * Desc:
+ *      Implementation of MetaScanner.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      The vector scanners are only built on x86. The implementation is
+ *      picked the first time scanDelimiters is called.
+ */
+
+// Include guard
+#ifndef METASCANNER_C
+#define METASCANNER_C
+
+// Include header
+#include "MetaScanner.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+static void scanScalar( const char *block, struct DelimiterMasks *masks );
+static void scanSelect( const char *block, struct DelimiterMasks *masks );
+
+// Scanner in use, replaced by scanSelect on the first call
+static void ( *scanImplementation )( const char *,
+                                     struct DelimiterMasks * ) = scanSelect;
+static const char *scanImplementationName = "scalar";
+
+static void scanScalar( const char *block, struct DelimiterMasks *masks )
+{
+    masks->semicolons = 0;
+    masks->periods = 0;
+    masks->newlines = 0;
+    masks->openParens = 0;
+    masks->closeParens = 0;
+
+    for( int index = 0; ( index ) < ( SCAN_BLOCK_SIZE ); index++ )
+    {
+        uint64_t bit = (uint64_t) 1 << index;
+
+        switch( block[index] )
+        {
+            case ';':
+                masks->semicolons |= bit;
+                break;
+
+            case '.':
+                masks->periods |= bit;
+                break;
+
+            case '\n':
+                masks->newlines |= bit;
+                break;
+
+            case '(':
+                masks->openParens |= bit;
+                break;
+
+            case ')':
+                masks->closeParens |= bit;
+                break;
+        }
+    }
+}
+
+#ifdef SCAN_X86
+static void scanSse2( const char *block, struct DelimiterMasks *masks )
+{
+    const __m128i semicolon = _mm_set1_epi8( ';' );
+    const __m128i period = _mm_set1_epi8( '.' );
+    const __m128i newline = _mm_set1_epi8( '\n' );
+    const __m128i openParen = _mm_set1_epi8( '(' );
+    const __m128i closeParen = _mm_set1_epi8( ')' );
+
+    masks->semicolons = 0;
+    masks->periods = 0;
+    masks->newlines = 0;
+    masks->openParens = 0;
+    masks->closeParens = 0;
+
+    for( int lane = 0; ( lane ) < ( SCAN_BLOCK_SIZE / 16 ); lane++ )
+    {
+        __m128i bytes = _mm_loadu_si128( (const __m128i *) ( block + lane * 16 ) );
+        int shift = lane * 16;
+
+        masks->semicolons |= (uint64_t) (uint16_t) _mm_movemask_epi8(
+                             _mm_cmpeq_epi8( bytes, semicolon ) ) << shift;
+        masks->periods |= (uint64_t) (uint16_t) _mm_movemask_epi8(
+                          _mm_cmpeq_epi8( bytes, period ) ) << shift;
+        masks->newlines |= (uint64_t) (uint16_t) _mm_movemask_epi8(
+                           _mm_cmpeq_epi8( bytes, newline ) ) << shift;
+        masks->openParens |= (uint64_t) (uint16_t) _mm_movemask_epi8(
+                             _mm_cmpeq_epi8( bytes, openParen ) ) << shift;
+        masks->closeParens |= (uint64_t) (uint16_t) _mm_movemask_epi8(
+                              _mm_cmpeq_epi8( bytes, closeParen ) ) << shift;
+    }
+}
+
+__attribute__(( target( "avx2" ) ))
+static void scanAvx2( const char *block, struct DelimiterMasks *masks )
+{
+    const __m256i semicolon = _mm256_set1_epi8( ';' );
+    const __m256i period = _mm256_set1_epi8( '.' );
+    const __m256i newline = _mm256_set1_epi8( '\n' );
+    const __m256i openParen = _mm256_set1_epi8( '(' );
+    const __m256i closeParen = _mm256_set1_epi8( ')' );
+    __m256i low = _mm256_loadu_si256( (const __m256i *) block );
+    __m256i high = _mm256_loadu_si256( (const __m256i *) ( block + 32 ) );
+
+    masks->semicolons =
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( low, semicolon ) ) |
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( high, semicolon ) ) << 32;
+    masks->periods =
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( low, period ) ) |
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( high, period ) ) << 32;
+    masks->newlines =
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( low, newline ) ) |
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( high, newline ) ) << 32;
+    masks->openParens =
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( low, openParen ) ) |
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( high, openParen ) ) << 32;
+    masks->closeParens =
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( low, closeParen ) ) |
+        (uint64_t) (uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8( high, closeParen ) ) << 32;
+}
+#endif
+
+static void scanSelect( const char *block, struct DelimiterMasks *masks )
+{
+    scanImplementation = scanScalar;
+    scanImplementationName = "scalar";
+
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx2" ) )
+    {
+        scanImplementation = scanAvx2;
+        scanImplementationName = "avx2";
+    }
+    else if( __builtin_cpu_supports( "sse2" ) )
+    {
+        scanImplementation = scanSse2;
+        scanImplementationName = "sse2";
+    }
+#endif
+
+    scanImplementation( block, masks );
+}
+
+// Begin implementation
+void scanDelimiters( const char *block, struct DelimiterMasks *masks )
+{
+    /**
+     * Desc:
+     *      Find the meta data delimiters in a block of SCAN_BLOCK_SIZE bytes.
+     *
+     * Args:
+     *      block (const char*): first byte of the block, does not need to
+     *                           be aligned
+     *      masks (struct DelimiterMasks*): receives one mask per delimiter
+     */
+    scanImplementation( block, masks );
+}
+
+const char *scannerName( void )
+{
+    /**
+     * Desc:
+     *      Name of the scanner picked for this host.
+     *
+     * Returns:
+     *      "avx2", "sse2" or "scalar". Always "scalar" before the first
+     *      scanDelimiters call.
+     */
+    return scanImplementationName;
+}
+
+size_t parseCycles( const char *str, long long *cycles )
+{
+    /**
+     * Desc:
+     *      Parse a cycle count the same way sscanf's %lld does: leading
+     *      blanks, an optional sign, then at least one digit. Digits are
+     *      converted eight at a time within a 64 bit word, byte swapped
+     *      first on big endian hosts.
+     *
+     * Args:
+     *      str (const char*): text to parse, must have 8 readable bytes past
+     *                         the last digit
+     *      cycles (long long*): receives the parsed value
+     *
+     * Returns:
+     *      The number of digits read, 0 if there were none or the count
+     *      doesn't fit a long long.
+     */
+    static const long long SCALES[] = { 1, 10, 100, 1000, 10000, 100000,
+                                        1000000, 10000000, 100000000 };
+    const uint64_t zeros = 0x3030303030303030ULL;
+    long long value = 0;
+    size_t totalDigits = 0;
+    int sign = 1;
+
+    while( ( *str ) == ( ' ' ) || ( *str ) == ( '\t' ) ||
+           ( *str ) == ( '\v' ) || ( *str ) == ( '\f' ) || ( *str ) == ( '\r' ) )
+    {
+        str++;
+    }
+
+    if( ( *str ) == ( '-' ) )
+    {
+        sign = -1;
+        str++;
+    }
+    else if( ( *str ) == ( '+' ) )
+    {
+        str++;
+    }
+
+    while( 1 )
+    {
+        uint64_t chunk;
+        uint64_t nonDigits;
+        int digits;
+
+        __builtin_memcpy( &chunk, str, sizeof( chunk ) );
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        // The masks below expect the first char in the low byte
+        chunk = __builtin_bswap64( chunk );
+#endif
+        chunk ^= zeros;
+
+        // A byte is a digit when its high nibble is 0 and adding 6 does not
+        // carry into bit 4. Carries only leak upward from a non-digit, past
+        // the point we care about.
+        nonDigits = ( chunk & 0xF0F0F0F0F0F0F0F0ULL ) |
+                    ( ( chunk + 0x0606060606060606ULL ) & 0x1010101010101010ULL );
+        digits = nonDigits == 0 ? 8 : __builtin_ctzll( nonDigits ) / 8;
+
+        if( ( digits ) == ( 0 ) )
+        {
+            break;
+        }
+
+        // Move the digits to the top so the empty bytes act as leading zeros
+        if( ( digits ) < ( 8 ) )
+        {
+            chunk <<= 8 * ( 8 - digits );
+        }
+
+        chunk = ( chunk * 10 + ( chunk >> 8 ) ) & 0x00FF00FF00FF00FFULL;
+        chunk = ( chunk * 100 + ( chunk >> 16 ) ) & 0x0000FFFF0000FFFFULL;
+        chunk = ( chunk * 10000 + ( chunk >> 32 ) ) & 0x00000000FFFFFFFFULL;
+
+        if( __builtin_mul_overflow( value, SCALES[digits], &value ) ||
+            __builtin_add_overflow( value, (long long) chunk, &value ) )
+        {
+            return 0;
+        }
+
+        totalDigits += digits;
+        str += digits;
+
+        if( ( digits ) < ( 8 ) )
+        {
+            break;
+        }
+    }
+
+    *cycles = value * sign;
+    return totalDigits;
+}
+
+// End include guard
+#endif              // METASCANNER_C
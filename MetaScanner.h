@@ -0,0 +1,42 @@
+/**
+ * Name:
+ *      MetaScanner.h
+ *
+ * Desc:
+ *      Delimiter scanner and cycle count parser for the meta data
+ *      tokenizer. Delimiters are found 64 bytes at a time with AVX2 or SSE2
+ *      when the host supports it, falling back to a scalar loop otherwise.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef METASCANNER_H
+#define METASCANNER_H
+
+// Bytes handled by one scanDelimiters call. Buffers handed to the scanner
+// must have this many readable bytes past the last one scanned.
+#define SCAN_BLOCK_SIZE 64
+
+// Include header
+#include <stdint.h>
+#include <stddef.h>
+
+// One bit per byte of a scanned block, bit 0 is the first byte
+struct DelimiterMasks
+{
+    uint64_t semicolons;
+    uint64_t periods;
+    uint64_t newlines;
+    uint64_t openParens;
+    uint64_t closeParens;
+};
+
+// Function headers
+void scanDelimiters( const char *block, struct DelimiterMasks *masks );
+const char *scannerName( void );
+size_t parseCycles( const char *str, long long *cycles );
+
+// End include guard
+#endif              // METASCANNER_H
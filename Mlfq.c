@@ -0,0 +1,218 @@
+/**
+ * Name:
+ *      Mlfq.c
+ *
+ * Desc:
+ *      Multi-level feedback queue scheduling policy.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Processes start on the top level and run round robin within a
+ *      level. Once a process has used up the quantum of its level, over
+ *      however many turns, it moves down a level. Every boost interval of
+ *      simulated time every process goes back to the top, so long running
+ *      processes are not starved by interactive ones.
+ */
+
+// Include guard
+#ifndef MLFQ_C
+#define MLFQ_C
+
+// Include header
+#include "Scheduler.h"
+#include "ProcessPcb.h"
+
+// MLFQ state
+//      queues holds one ring buffer per level, each big enough for every
+//      process. level and used are per process, used counts the cycles
+//      run on the current level.
+struct MlfqState
+{
+    struct pcb *pcbArray;
+    int levelCount;
+    long long quanta[MLFQ_MAX_LEVELS];
+    int *queues[MLFQ_MAX_LEVELS];
+    int heads[MLFQ_MAX_LEVELS];
+    int counts[MLFQ_MAX_LEVELS];
+    int capacity;
+    int *level;
+    long long *used;
+    long long boostInterval;
+    long long nextBoost;
+};
+
+static void mlfqPush( struct MlfqState *mlfq, int level, int processIndex )
+{
+    mlfq->queues[level][( mlfq->heads[level] + mlfq->counts[level] )
+                        % mlfq->capacity] = processIndex;
+    mlfq->counts[level]++;
+}
+
+static int mlfqPop( struct MlfqState *mlfq, int level )
+{
+    int processIndex = mlfq->queues[level][mlfq->heads[level]];
+
+    mlfq->heads[level] = ( mlfq->heads[level] + 1 ) % mlfq->capacity;
+    mlfq->counts[level]--;
+    return processIndex;
+}
+
+static void mlfqBoost( struct MlfqState *mlfq )
+{
+    /**
+     * Desc:
+     *      Move every process back to the top level once the boost
+     *      interval has passed. Queued processes keep their order, higher
+     *      levels first.
+     *
+     * Args:
+     *      mlfq (struct MlfqState*): policy state
+     */
+    long long now = simulatedTime() / 1000;
+
+    if( ( mlfq->boostInterval ) <= ( 0 ) || ( now ) < ( mlfq->nextBoost ) )
+    {
+        return;
+    }
+
+    for( int level = 1; ( level ) < ( mlfq->levelCount ); level++ )
+    {
+        while( ( mlfq->counts[level] ) > ( 0 ) )
+        {
+            mlfqPush( mlfq, 0, mlfqPop( mlfq, level ) );
+        }
+    }
+
+    for( int index = 0; ( index ) < ( mlfq->capacity ); index++ )
+    {
+        mlfq->level[index] = 0;
+        mlfq->used[index] = 0;
+    }
+
+    while( ( mlfq->nextBoost ) <= ( now ) )
+    {
+        mlfq->nextBoost += mlfq->boostInterval;
+    }
+}
+
+static void *mlfqCreate( CfgData *data, struct pcb *pcbArray, int arraySize )
+{
+    struct MlfqState *mlfq = malloc( sizeof( struct MlfqState ) );
+
+    mlfq->pcbArray = pcbArray;
+    mlfq->levelCount = data->mlfqLevels;
+    mlfq->capacity = arraySize > 0 ? arraySize : 1;
+    mlfq->level = calloc( mlfq->capacity, sizeof( int ) );
+    mlfq->used = calloc( mlfq->capacity, sizeof( long long ) );
+    mlfq->boostInterval = data->mlfqBoostInterval;
+    mlfq->nextBoost = data->mlfqBoostInterval;
+
+    for( int level = 0; ( level ) < ( mlfq->levelCount ); level++ )
+    {
+        mlfq->quanta[level] = data->mlfqQuanta[level];
+        mlfq->queues[level] = malloc( sizeof( int ) * mlfq->capacity );
+        mlfq->heads[level] = 0;
+        mlfq->counts[level] = 0;
+    }
+
+    return mlfq;
+}
+
+static void mlfqDestroy( void *state )
+{
+    struct MlfqState *mlfq = state;
+
+    for( int level = 0; ( level ) < ( mlfq->levelCount ); level++ )
+    {
+        free( mlfq->queues[level] );
+    }
+
+    free( mlfq->level );
+    free( mlfq->used );
+    free( mlfq );
+}
+
+static void mlfqEnqueue( void *state, int processIndex )
+{
+    struct MlfqState *mlfq = state;
+
+    // A process that hasn't run yet starts at the top, even in a reused slot
+    if( ( mlfq->pcbArray[processIndex].memory ) == ( NULL ) )
+    {
+        mlfq->level[processIndex] = 0;
+        mlfq->used[processIndex] = 0;
+    }
+
+    mlfqPush( mlfq, mlfq->level[processIndex], processIndex );
+}
+
+static int mlfqPickNext( void *state )
+{
+    struct MlfqState *mlfq = state;
+
+    mlfqBoost( mlfq );
+
+    for( int level = 0; ( level ) < ( mlfq->levelCount ); level++ )
+    {
+        if( ( mlfq->counts[level] ) > ( 0 ) )
+        {
+            return mlfqPop( mlfq, level );
+        }
+    }
+
+    return -1;
+}
+
+static long long mlfqQuantum( void *state, int processIndex )
+{
+    struct MlfqState *mlfq = state;
+
+    return mlfq->quanta[mlfq->level[processIndex]] - mlfq->used[processIndex];
+}
+
+static int mlfqOnTick( void *state, int processIndex, long long cycles )
+{
+    struct MlfqState *mlfq = state;
+    int level = mlfq->level[processIndex];
+
+    mlfq->used[processIndex] += cycles;
+
+    // Used up its allotment, move down a level
+    if( ( mlfq->used[processIndex] ) >= ( mlfq->quanta[level] ) )
+    {
+        if( ( level + 1 ) < ( mlfq->levelCount ) )
+        {
+            mlfq->level[processIndex] = level + 1;
+        }
+
+        mlfq->used[processIndex] = 0;
+        return 1;
+    }
+
+    // A process woke up on a higher level
+    for( int higher = 0; ( higher ) < ( level ); higher++ )
+    {
+        if( ( mlfq->counts[higher] ) > ( 0 ) )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void mlfqOnBlock( void *state, int processIndex )
+{
+    // Keeps its level and the cycles it used there
+    (void) state;
+    (void) processIndex;
+}
+
+const struct SchedulerOps MLFQ_SCHEDULER = { "MLFQ", 1, mlfqCreate,
+    mlfqDestroy, mlfqEnqueue, mlfqPickNext, mlfqQuantum, mlfqOnTick,
+    mlfqOnBlock, mlfqEnqueue };
+
+// End include guard
+#endif              // MLFQ_C
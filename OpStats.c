@@ -0,0 +1,312 @@
+/**
+ * Name:
+ *      OpStats.c
+ *
+ * Desc:
+ *      Implementation of OpStats.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      The requested time of an op is the simulated time between its start
+ *      and end, which is cycles times the cycle time unless the op waited
+ *      in a device queue or was preempted. The actual time is what
+ *      accessTimer reported for the same two events, so in real time mode
+ *      the ratio shows how far the host wait drifted, and in virtual mode
+ *      it is always 1. Ratios are kept in thousandths, overshoot in usec.
+ */
+
+// Include guard
+#ifndef OPSTATS_C
+#define OPSTATS_C
+
+// Include header
+#include "OpStats.h"
+
+// Start of the op a process has open, -1 when it has none
+struct OpStart
+{
+    long long observed;
+    long long simulated;
+};
+
+// Statistics state, one ratio and one overshoot histogram per op code
+static struct OpHistogram ratios[OP_CODE_COUNT];
+static struct OpHistogram overshoots[OP_CODE_COUNT];
+static int opStatsOn = 0;
+static struct OpStart *opStarts = NULL;
+static int opStartCapacity = 0;
+
+static int histogramIndex( long long value )
+{
+    /**
+     * Desc:
+     *      Bucket a value falls in.
+     *
+     * Args:
+     *      value (long long): non negative value
+     *
+     * Returns:
+     *      The bucket index.
+     */
+    int shift = 0;
+
+    if( ( value ) < ( OPSTATS_SUB_BUCKETS ) )
+    {
+        return (int) value;
+    }
+
+    while( ( value >> shift ) >= ( OPSTATS_SUB_BUCKETS ) )
+    {
+        shift++;
+    }
+
+    return shift * OPSTATS_HALF_BUCKETS + (int) ( value >> shift );
+}
+
+static long long histogramValue( int index )
+{
+    /**
+     * Desc:
+     *      Highest value that falls in a bucket.
+     *
+     * Args:
+     *      index (int): bucket index
+     *
+     * Returns:
+     *      The value.
+     */
+    int shift;
+
+    if( ( index ) < ( OPSTATS_SUB_BUCKETS ) )
+    {
+        return index;
+    }
+
+    shift = index / OPSTATS_HALF_BUCKETS - 1;
+    return ( (long long) ( index - shift * OPSTATS_HALF_BUCKETS + 1 ) << shift )
+           - 1;
+}
+
+static void histogramAdd( struct OpHistogram *histogram, long long value )
+{
+    if( ( value ) < ( 0 ) )
+    {
+        value = 0;
+    }
+
+    histogram->counts[histogramIndex( value )]++;
+    histogram->total++;
+
+    if( ( value ) > ( histogram->max ) )
+    {
+        histogram->max = value;
+    }
+}
+
+static long long histogramPercentile( const struct OpHistogram *histogram,
+                                      int percent )
+{
+    /**
+     * Desc:
+     *      Value at a percentile, never more than the largest value added.
+     *
+     * Args:
+     *      histogram (const struct OpHistogram*): histogram with samples
+     *      percent (int): percentile, 0 to 100
+     *
+     * Returns:
+     *      The value.
+     */
+    long long rank = ( histogram->total * percent + 99 ) / 100;
+    long long seen = 0;
+
+    if( ( rank ) < ( 1 ) )
+    {
+        rank = 1;
+    }
+
+    for( int index = 0; ( index ) < ( OPSTATS_BUCKETS ); index++ )
+    {
+        seen += histogram->counts[index];
+
+        if( ( seen ) >= ( rank ) )
+        {
+            long long value = histogramValue( index );
+
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+static struct OpStart *opStart( int processId )
+{
+    /**
+     * Desc:
+     *      Open op of a process, growing the table the first time a
+     *      process shows up.
+     *
+     * Args:
+     *      processId (int): id of the process
+     *
+     * Returns:
+     *      The op start entry.
+     */
+    if( ( processId ) >= ( opStartCapacity ) )
+    {
+        int capacity = opStartCapacity > 0 ? opStartCapacity : 64;
+
+        while( ( capacity ) <= ( processId ) )
+        {
+            capacity *= 2;
+        }
+
+        opStarts = realloc( opStarts, sizeof( struct OpStart ) * capacity );
+        for( int index = opStartCapacity; ( index ) < ( capacity ); index++ )
+        {
+            opStarts[index].simulated = -1;
+        }
+
+        opStartCapacity = capacity;
+    }
+
+    return &opStarts[processId];
+}
+
+// Begin implementation
+void opStatsEnable( void )
+{
+    /**
+     * Desc:
+     *      Start keeping op statistics. Until then opStatsRecord does
+     *      nothing, so runs that don't print them don't pay for them.
+     */
+    opStatsOn = 1;
+}
+
+void opStatsRecord( const struct SimEvent *event, double observed,
+                    long long simulated )
+{
+    /**
+     * Desc:
+     *      Note the start of an op, or add a finished op to the histograms
+     *      of its op code.
+     *
+     * Args:
+     *      event (const struct SimEvent*): event that was logged
+     *      observed (double): time accessTimer reported, in seconds
+     *      simulated (long long): simulated time of the event
+     */
+    long long observedUSec = (long long) ( observed * 1000000 + 0.5 );
+    struct OpStart *start;
+
+    if( ( opStatsOn ) == ( 0 ) || ( event->processId ) < ( 0 ) ||
+        ( event->opIndex ) < ( 0 ) )
+    {
+        return;
+    }
+
+    start = opStart( event->processId );
+
+    if( ( event->type ) == ( EVENT_OP_START ) ||
+        ( event->type ) == ( EVENT_MMU_START ) )
+    {
+        start->observed = observedUSec;
+        start->simulated = simulated;
+        return;
+    }
+
+    if( ( ( event->type ) != ( EVENT_OP_END ) &&
+          ( event->type ) != ( EVENT_MMU_RESULT ) ) ||
+        ( start->simulated ) < ( 0 ) )
+    {
+        return;
+    }
+
+    long long actual = observedUSec - start->observed;
+    long long requested = simulated - start->simulated;
+
+    // Ops that take no simulated time have no meaningful ratio
+    if( ( requested ) > ( 0 ) )
+    {
+        histogramAdd( &ratios[event->opIndex], actual * 1000 / requested );
+    }
+
+    histogramAdd( &overshoots[event->opIndex], actual - requested );
+    start->simulated = -1;
+}
+
+void opStatsPrint( void )
+{
+    /**
+     * Desc:
+     *      Print the ratio and overshoot percentiles of every op code that
+     *      finished at least one op.
+     */
+    static const int PERCENTS[] = { 50, 90, 99 };
+
+    printf( "\n___________OP LATENCY___________\n" );
+    printf( "%-11s %8s %9s %9s %9s %9s %11s %11s %11s %11s\n", "Op", "Count",
+            "Ratio p50", "Ratio p90", "Ratio p99", "Ratio max", "Over p50 us",
+            "Over p90 us", "Over p99 us", "Over max us" );
+
+    for( int opCode = 0; ( opCode ) < ( OP_CODE_COUNT ); opCode++ )
+    {
+        struct OpHistogram *ratio = &ratios[opCode];
+        struct OpHistogram *overshoot = &overshoots[opCode];
+
+        if( ( overshoot->total ) == ( 0 ) )
+        {
+            continue;
+        }
+
+        printf( "%-11s %8lld", META_LEGAL_OP_STRINGS[opCode],
+                overshoot->total );
+
+        for( int percent = 0; ( percent ) < ( 3 ); percent++ )
+        {
+            if( ( ratio->total ) == ( 0 ) )
+            {
+                printf( " %9s", "-" );
+                continue;
+            }
+
+            printf( " %9.3f",
+                    histogramPercentile( ratio, PERCENTS[percent] ) / 1000.0 );
+        }
+
+        if( ( ratio->total ) == ( 0 ) )
+        {
+            printf( " %9s", "-" );
+        }
+        else
+        {
+            printf( " %9.3f", ratio->max / 1000.0 );
+        }
+
+        for( int percent = 0; ( percent ) < ( 3 ); percent++ )
+        {
+            printf( " %11lld",
+                    histogramPercentile( overshoot, PERCENTS[percent] ) );
+        }
+
+        printf( " %11lld\n", overshoot->max );
+    }
+}
+
+void opStatsFree( void )
+{
+    /**
+     * Desc:
+     *      Free the open op table.
+     */
+    free( opStarts );
+    opStarts = NULL;
+    opStartCapacity = 0;
+}
+
+// End include guard
+#endif              // OPSTATS_C
@@ -0,0 +1,50 @@
+/**
+ * Name:
+ *      OpStats.h
+ *
+ * Desc:
+ *      Op latency statistics. For every op the time accessTimer observed
+ *      is compared with the simulated time the op asked for, and the
+ *      ratio and overshoot are kept in log-linear histograms per op type.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef OPSTATS_H
+#define OPSTATS_H
+
+// Histogram layout
+//      Values below OPSTATS_SUB_BUCKETS get a bucket each, above that every
+//      power of two is split into OPSTATS_SUB_BUCKETS / 2 buckets, so any
+//      value is within about 3% of its bucket.
+#define OPSTATS_SUB_BITS     6
+#define OPSTATS_SUB_BUCKETS  ( 1 << OPSTATS_SUB_BITS )
+#define OPSTATS_HALF_BUCKETS ( OPSTATS_SUB_BUCKETS / 2 )
+#define OPSTATS_BUCKETS      ( OPSTATS_HALF_BUCKETS * ( 64 - OPSTATS_SUB_BITS ) \
+                               + OPSTATS_SUB_BUCKETS )
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+#include "SimEvent.h"
+
+// Log-linear histogram of non negative values
+struct OpHistogram
+{
+    long long counts[OPSTATS_BUCKETS];
+    long long total;
+    long long max;
+};
+
+// Function headers
+void opStatsEnable( void );
+void opStatsRecord( const struct SimEvent *event, double observed,
+                    long long simulated );
+void opStatsPrint( void );
+void opStatsFree( void );
+
+// End include guard
+#endif              // OPSTATS_H
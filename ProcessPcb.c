@@ -17,215 +17,364 @@
 #include "ProcessPcb.h"
 
 const int BUFF_SIZE = 255;
-const char *META_LEGAL_PROGRAM_STATES[] = {"New", "Waiting", "Running", "Exit"};
-// Constants to define schedule and log modes in the config
-const char *CONFIG_SCHED_MODES2[] = {"FCFS-N", "SJF-N", "SRTF-P",
-                                    "FCFS-P", "RR-P"};
 
-int getNumStartSymbols( struct LinkedList *head )
+struct pcb *storePcb( struct MetaData *metaData, CfgData *data )
 {
-    struct LinkedList *currentNode = head->next;
-    int count = 0;
-    while( currentNode != NULL )
+    int count = metaData->processCount;
+    struct pcb *pcbArray = malloc(sizeof(struct pcb) * count);
+    struct ProgramCursor cursor = { 0 };
+
+    //repeats around programs are only run here, one process at a time
+    for( int processCount = 0; processCount < count; processCount++ )
     {
-        if( *(char*)currentNode->data[0] == 'A' &&
-            compareString( currentNode->data[1], "start" ) == 1 )
-        {
-         count++;
-        }
-	      currentNode = currentNode->next;
+        initPcb( &pcbArray[processCount], metaData,
+            nextProgram( metaData, &cursor ), processCount, data );
     }
-    return count;
+
+    return pcbArray;
 }
 
-struct pcb *storePcb( struct LinkedList *metaData, CfgData *data )
+void initPcb( struct pcb *process, struct MetaData *metaData, int program,
+    int processCounter, CfgData *data )
 {
-    int startSymbols = getNumStartSymbols(metaData->next);
-    struct pcb *pcbArray = malloc(sizeof(struct pcb) * startSymbols);
-    struct LinkedList *currentNode = metaData->next;
-    int count = 0;
+    struct ProcessIndex *index = &metaData->processes[program];
+    process->program = index;
+    process->metaDataPointer = metaData->ops + index->offset;
+    process->repeats = NULL;
+    process->repeatDepth = 0;
+    if( index->repeatDepth > 0 )
+    {
+        process->repeats = malloc( sizeof( struct RepeatFrame ) *
+            index->repeatDepth );
+    }
+    process->processCounter = processCounter;
+    process->processCycle = process->metaDataPointer->cycles;
+    process->state = -1;
+    process->statePrev = -1;
+    process->stateNext = -1;
+    process->memory = NULL;
+    process->remainingTime = estimatePcbTime( index, data );
+}
 
-    while( currentNode != NULL && count < startSymbols)
+struct LogFile *processPcbArray( struct pcb *pcbArrayPointer, CfgData *data, int arraySize )
+{
+    char *timeBuffer = (char *)malloc(BUFFER_SIZE);
+    char *logLine = (char *)malloc(BUFFER_SIZE);
+    struct LogFile *logFile = logFileCreate();
+    const struct SchedulerOps *scheduler = schedulerFor( data->cpuSchedulingCode );
+    struct SimContext context = { pcbArrayPointer, arraySize, data, logFile,
+        logLine, timeBuffer, scheduler,
+        scheduler->create( data, pcbArrayPointer, arraySize ) };
+    int finished = 0;
+
+    logSinkStart( data, logFile );
+    processStatesStart( pcbArrayPointer );
+    for( int processCount = 0; processCount < arraySize; processCount++ )
     {
-        if( *(char*)currentNode->data[0] == 'A' && compareString( (char*)currentNode->data[1], "start" ) )
+        processStateAdd( &pcbArrayPointer[processCount] );
+    }
+    startOperatingSystemOps(timeBuffer, logFile, logLine, data);
+    devicesStart( data );
+    cacheStart( data );
+    swapStart( data, arraySize );
+    dispatchCostStart( data );
+    admissionStart( data, &context );
+
+    //with admission control processes stay new until they fit
+    if( admissionEnabled() )
+    {
+        admitProcesses( &context );
+    }
+    else
+    {
+        setPcbArrayToReady(pcbArrayPointer, arraySize, logFile, logLine, data, timeBuffer);
+
+        PROFILE_ENTER( PROFILE_SCHED_DECISION );
+        for( int processCount = 0; processCount < arraySize; processCount++ )
         {
-            struct pcb *newPcb = malloc(sizeof(struct pcb));
-            newPcb->metaDataPointer = (struct LinkedList*)currentNode;
-            newPcb->processCounter = count;
-            newPcb->processCycle = *(int*)currentNode->data[2];
-            newPcb->processState = "New";
-            pcbArray[count] = *newPcb;
-            currentNode = currentNode->next;
-            count++;
-            free(newPcb);
+            scheduler->enqueue( context.schedulerState, processCount );
         }
-	      currentNode = currentNode->next;
+        PROFILE_LEAVE( PROFILE_SCHED_DECISION );
     }
 
-    if( data->cpuSchedulingCode == 1 )
+    while( finished < arraySize )
     {
-        pcbArray = reorderSJF( pcbArray, data, count );
+        PROFILE_ENTER( PROFILE_SCHED_DECISION );
+        int processCount = scheduler->pickNext( context.schedulerState );
+        PROFILE_LEAVE( PROFILE_SCHED_DECISION );
+
+        //every process left is waiting on a device, idle until one is done
+        if( processCount < 0 )
+        {
+            long long next = devicesNextCompletion();
+            if( next == DEVICE_IDLE )
+            {
+                break;
+            }
+            runUntil( &context, next );
+            continue;
+        }
+
+        if( dispatchProcess( &context, processCount ) == 0 )
+        {
+            continue;
+        }
+
+        finished++;
+
+        if( admissionEnabled() )
+        {
+            admissionRelease( processCount );
+            admitProcesses( &context );
+        }
     }
 
-    return pcbArray;
+    endOperatingSystemOps( timeBuffer, logFile, logLine, data );
+    logSinkFlush();
+    deallocateBuffers( timeBuffer, logLine );
+    scheduler->destroy( context.schedulerState );
+
+    return logFile;
 }
 
-struct pcb *reorderSJF( struct pcb *pcbArray, CfgData *data, int arraySize )
+int dispatchProcess( struct SimContext *context, int processIndex )
 {
-    for(int outer = 0; outer < arraySize; outer++ )
+    struct pcb *process = &context->pcbArray[processIndex];
+    CfgData *data = context->data;
+    struct SimEvent event = { EVENT_PROCESS_SELECTED,
+        process->processCounter, 0, -1,
+        process->program->procCycles, process->program->ioCycles,
+        process->program->deviceCycles };
+
+    //the scheduler decision and the switch take cpu time first
+    if( dispatchCostEnabled() )
+    {
+        dispatchCostCharge( context, processIndex );
+    }
+    logEvent( &event, data, context->logFile, context->logLine,
+        context->timeBuffer );
+
+    //move pcb into running
+    logStateChange( process, STATE_RUNNING, data, context->logFile,
+        context->logLine, context->timeBuffer );
+
+    //first time on the cpu, step past the A(start)
+    if( process->memory == NULL )
+    {
+        process->memory = memCreate();
+        updatePointerAndCycle( context->pcbArray, processIndex );
+    }
+
+    int result = runProcess( context, processIndex );
+
+    if( result == OP_BLOCKED )
+    {
+        logStateChange( process, STATE_WAITING, data, context->logFile,
+            context->logLine, context->timeBuffer );
+        context->scheduler->onBlock( context->schedulerState, processIndex );
+        return 0;
+    }
+
+    if( result == OP_PREEMPTED )
+    {
+        event.type = EVENT_PREEMPTED;
+        logEvent( &event, data, context->logFile, context->logLine,
+            context->timeBuffer );
+        logStateChange( process, STATE_READY, data, context->logFile,
+            context->logLine, context->timeBuffer );
+        context->scheduler->enqueue( context->schedulerState, processIndex );
+        return 0;
+    }
+
+    if( result == OP_FAILED )
     {
-        for( int inner = 0; inner < arraySize; inner++ )
+        event.type = EVENT_SEG_FAULT;
+        logEvent( &event, data, context->logFile, context->logLine,
+            context->timeBuffer );
+    }
+
+    //exit the process
+    logStateChange( process, STATE_EXIT, data, context->logFile,
+        context->logLine, context->timeBuffer );
+    swapRelease( process->memory );
+    deallocateMemoryList( process->memory );
+    process->memory = NULL;
+    return 1;
+}
+
+int runProcess( struct SimContext *context, int processIndex )
+{
+    struct pcb *process = &context->pcbArray[processIndex];
+
+    //process all of the ops in a pcb until it ends or blocks
+    while( process->metaDataPointer->component != 'A' )
+    {
+        PROFILE_ENTER( PROFILE_OP_DISPATCH );
+        int opResult = processPcbLine( context, processIndex );
+        PROFILE_LEAVE( PROFILE_OP_DISPATCH );
+
+        if( opResult != OP_DONE )
         {
-            if( estimatePcbTime( pcbArray[outer].metaDataPointer, data ) <=
-                estimatePcbTime( pcbArray[inner].metaDataPointer, data ))
-            {
-                struct pcb temp = pcbArray[outer];
-                pcbArray[outer] = pcbArray[inner];
-                pcbArray[inner] = temp;
-            }
+            return opResult;
         }
+
+        updatePointerAndCycle( context->pcbArray, processIndex );
     }
-    return pcbArray;
+
+    return OP_DONE;
 }
 
-struct LogFile *processPcbArray( struct pcb *pcbArrayPointer, CfgData *data, int arraySize )
+void runUntil( struct SimContext *context, long long target )
 {
-    char *timeBuffer = (char *)malloc(BUFFER_SIZE);
-    char *logLine = (char *)malloc(BUFFER_SIZE);
-    struct LogFile *logFile = logFileCreate();
+    long long next = devicesNextCompletion();
+    struct DeviceRequest request;
 
-    startOperatingSystemOps(timeBuffer, logFile, logLine, data->logTo);
-    setPcbArrayToReady(pcbArrayPointer, arraySize, logFile, logLine, data->logTo, timeBuffer);
-
-    for(int processCount = 0; processCount < arraySize; processCount++)
-    {
-        struct Memory *memory = memCreate();
-        sprintf(logLine, "Time:  %f, OS: %s Strategy selects Process %d with time: %d mSec\n",
-            accessTimer(1, timeBuffer),
-            CONFIG_SCHED_MODES2[data->cpuSchedulingCode],
-            pcbArrayPointer[processCount].processCounter,
-            estimatePcbTime( pcbArrayPointer[processCount].metaDataPointer, data ));
-        addLineToLogFile(logLine, logFile, data->logTo);
-        logLine = clearArray( logLine );
-
-        //move pcb into running
-        pcbArrayPointer[processCount].processState = "Running";
-        sprintf(logLine, "Time:  %f, OS: Process %d set in %s state\n",
-            accessTimer(1, timeBuffer),
-            pcbArrayPointer[processCount].processCounter,
-            pcbArrayPointer[processCount].processState);
-        addLineToLogFile(logLine, logFile, data->logTo);
-        logLine = clearArray( logLine );
-
-        updatePointerAndCycle(pcbArrayPointer, processCount);
-
-        //process all of the ops in a pcb
-        while( *(char*)pcbArrayPointer[processCount].metaDataPointer->data[0] != 'A'
-                && compareString( pcbArrayPointer[processCount].processState, "Running" )  )
+    //finish every device request that is done before target
+    while( next != DEVICE_IDLE && next <= target )
+    {
+        PROFILE_ENTER( PROFILE_TIMER_WAIT );
+        advanceTimer( next - simulatedTime() );
+        PROFILE_LEAVE( PROFILE_TIMER_WAIT );
+        int processIndex = devicesComplete( next, &request );
+        chromeTraceDevice( &request );
+        if( request.swap )
         {
-            //process one operation in the pcb
-            if ( processPcbLine(data, &pcbArrayPointer[processCount], memory, timeBuffer, logLine, logFile) == 1 )
-            {
-                updatePointerAndCycle(pcbArrayPointer, processCount);
-            }
-            else
-            {
-                sprintf(logLine, "Time:  %f, OS: Process %d Segmentation Fault - Process ended\n",
-                    accessTimer(1, timeBuffer),
-                    pcbArrayPointer[processCount].processCounter);
-                addLineToLogFile(logLine, logFile, data->logTo);
-                break;
-            }
+            swapComplete( processIndex );
+        }
+        else
+        {
+            completeIo( context, processIndex );
         }
+        next = devicesNextCompletion();
+    }
 
-        //exit the process
-        pcbArrayPointer[processCount].processState = "Exit";
-        sprintf(logLine, "Time:  %f, OS: Process %d set in %s state\n",
-            accessTimer(1, timeBuffer),
-            pcbArrayPointer[processCount].processCounter,
-            pcbArrayPointer[processCount].processState);
-        addLineToLogFile(logLine, logFile, data->logTo);
-        logLine = clearArray( logLine );
-        deallocateMemoryList( memory );
+    //waiting on idle devices has nothing to wait for
+    if( target == DEVICE_IDLE )
+    {
+        return;
     }
 
-    endOperatingSystemOps( timeBuffer, logFile, logLine, data->logTo );
-    deallocateBuffers( timeBuffer, logLine );
+    PROFILE_ENTER( PROFILE_TIMER_WAIT );
+    advanceTimer( target - simulatedTime() );
+    PROFILE_LEAVE( PROFILE_TIMER_WAIT );
+}
 
-    return logFile;
+void completeIo( struct SimContext *context, int processIndex )
+{
+    struct pcb *process = &context->pcbArray[processIndex];
+    struct SimEvent event = { EVENT_OP_END, process->processCounter,
+        process->metaDataPointer->component, process->metaDataPointer->opCode,
+        process->processCycle, 0, NULL };
+
+    logEvent( &event, context->data, context->logFile, context->logLine,
+        context->timeBuffer );
+    process->remainingTime -= process->processCycle *
+        deviceCycleTime( context->data, process->metaDataPointer->opCode );
+
+    //a blocked process moves on to its next op and waits for the cpu
+    if( context->scheduler->preemptive )
+    {
+        updatePointerAndCycle( context->pcbArray, processIndex );
+        logStateChange( process, STATE_READY, context->data, context->logFile,
+            context->logLine, context->timeBuffer );
+        PROFILE_ENTER( PROFILE_SCHED_DECISION );
+        context->scheduler->onWakeup( context->schedulerState, processIndex );
+        PROFILE_LEAVE( PROFILE_SCHED_DECISION );
+    }
 }
 
-void startOperatingSystemOps( char *timeBuffer, struct LogFile *logFile, char *logLine, int logTo )
+void startOperatingSystemOps( char *timeBuffer, struct LogFile *logFile, char *logLine, CfgData *data )
 {
     //handle operating system operations
+    struct SimEvent event = { EVENT_SYSTEM_START, -1, 0, -1, 0, 0, NULL };
     accessTimer( 0, timeBuffer );
     accessTimer( 1, timeBuffer );
-    sprintf(logLine, "Time:  %f, OS: System Start\n", accessTimer( 1, timeBuffer ));
-    addLineToLogFile( logLine, logFile, logTo );
-    logLine = clearArray( logLine );
-    sprintf( logLine, "Time:  %f, OS: Begin PCB Creation\n", accessTimer( 1, timeBuffer ) );
-    addLineToLogFile( logLine, logFile, logTo );
-    logLine = clearArray( logLine );
-    sprintf( logLine, "Time:  %f, OS: All Processes initialized in New state\n",
-        accessTimer( 1, timeBuffer ) );
-    addLineToLogFile( logLine, logFile, logTo );
-    logLine = clearArray( logLine );
+    logEvent( &event, data, logFile, logLine, timeBuffer );
+    event.type = EVENT_PCB_CREATION;
+    logEvent( &event, data, logFile, logLine, timeBuffer );
+    event.type = EVENT_ALL_NEW;
+    logEvent( &event, data, logFile, logLine, timeBuffer );
 }
 
 void setPcbArrayToReady( struct pcb *pcbArray, int arrayLength,
-    struct LogFile *logFile, char *logLine, int logTo, char *timeBuffer )
+    struct LogFile *logFile, char *logLine, CfgData *data, char *timeBuffer )
 {
-    for( int processCount = 0; processCount <= arrayLength; processCount++ )
+    struct SimEvent event = { EVENT_ALL_READY, -1, 0, -1, 0, 0, NULL };
+    for( int processCount = 0; processCount < arrayLength; processCount++ )
     {
-        pcbArray[processCount].processState = "Ready";
+        processStateMove( &pcbArray[processCount], STATE_READY );
     }
-    sprintf( logLine, "Time:  %f, OS: All Processes now set to Ready state\n",
-        accessTimer( 1, timeBuffer ) );
-    addLineToLogFile( logLine, logFile, logTo );
-    logLine = clearArray( logLine );
+    logEvent( &event, data, logFile, logLine, timeBuffer );
 }
 
-void endOperatingSystemOps(char *timeBuffer, struct LogFile *logFile, char *logLine, int logTo)
+void endOperatingSystemOps(char *timeBuffer, struct LogFile *logFile, char *logLine, CfgData *data)
 {
-    sprintf(logLine, "Time:  %f, OS: System stop\n", accessTimer( 1, timeBuffer ));
-    addLineToLogFile( logLine, logFile, logTo );
-    logLine = clearArray( logLine );
+    struct SimEvent event = { EVENT_SYSTEM_STOP, -1, 0, -1, 0, 0, NULL };
+    logEvent( &event, data, logFile, logLine, timeBuffer );
 }
 
-void updatePointerAndCycle( struct pcb *pcbArrayPointer, int processNumber )
+void logStateChange( struct pcb *process, int state, CfgData *data,
+    struct LogFile *logFile, char *logLine, char *timeBuffer )
 {
-    pcbArrayPointer[processNumber].metaDataPointer =
-        pcbArrayPointer[processNumber].metaDataPointer->next;
-    pcbArrayPointer[processNumber].processCycle =
-        *(int*)pcbArrayPointer[processNumber].metaDataPointer->data[2];
+    struct SimEvent event = { EVENT_PROCESS_STATE, process->processCounter,
+                              0, -1, state, 0, NULL };
+
+    //only legal moves are logged
+    if( processStateMove( process, state ) == 0 )
+    {
+        return;
+    }
+    logEvent( &event, data, logFile, logLine, timeBuffer );
 }
 
-void addLineToLogFile( char *line, struct LogFile *listHead, int logTo )
+void logEvent( struct SimEvent *event, CfgData *data, struct LogFile *logFile,
+    char *logLine, char *timeBuffer )
 {
-    switch ( logTo )
-    {
-        case 0: //monitor
-            printf("%s", line);
-            break;
+    double time = accessTimer( 1, timeBuffer );
+    traceRecord( event );
+    chromeTraceRecord( event, simulatedTime() );
+    opStatsRecord( event, time, simulatedTime() );
+    liveStatsRecord( event, simulatedTime() );
+    logSinkWrite( event, data, time, logFile, logLine );
+}
 
-        case 1: //file
-            logFileAppend( listHead, line );
-            break;
+void updatePointerAndCycle( struct pcb *pcbArrayPointer, int processNumber )
+{
+    struct pcb *process = &pcbArrayPointer[processNumber];
+    process->metaDataPointer++;
 
-        case 2: //both
-            logFileAppend( listHead, line );
-            printf("%s", line);
-            break;
+    //repeat ops only move the cursor, groups run without being expanded
+    while( process->metaDataPointer->component == 'R' )
+    {
+        struct RepeatFrame *frame = process->repeats + process->repeatDepth;
+        if( process->metaDataPointer->opCode == OP_START )
+        {
+            frame->body = process->metaDataPointer + 1;
+            frame->remaining = process->metaDataPointer->cycles;
+            process->repeatDepth++;
+            process->metaDataPointer++;
+        }
+        else if( --frame[-1].remaining > 0 )
+        {
+            process->metaDataPointer = frame[-1].body;
+        }
+        else
+        {
+            process->repeatDepth--;
+            process->metaDataPointer++;
+        }
     }
+
+    process->processCycle = process->metaDataPointer->cycles;
 }
 
 void createLogFile( struct LogFile *listHead, char *logPath )
 {
     struct LogFile *currentNode = listHead->next;
-    FILE *outFile = fopen( logPath, "w" );
+    FILE *outFile = fopen( logPath, "wb" );
     while( currentNode != NULL )
     {
-        fprintf( outFile, "%s", (char*)currentNode->data );
+        fwrite( currentNode->data, 1, currentNode->length, outFile );
         currentNode = currentNode->next;
     }
     fclose( outFile );
@@ -233,7 +382,7 @@ void createLogFile( struct LogFile *listHead, char *logPath )
 
 struct MMU *processMemoryRequest( struct pcb *memReq )
 {
-    int request = memReq->processCycle;
+    long long request = memReq->processCycle;
     struct MMU *newMmu = malloc( sizeof( struct MMU ) );
 
     newMmu->processId = memReq->processCounter;
@@ -245,230 +394,350 @@ struct MMU *processMemoryRequest( struct pcb *memReq )
 }
 
 int allocateMem( struct MMU *mmu, struct Memory *memory, CfgData *data )
+{
+    if( !checkAllocation( mmu, memory, data ) )
+    {
+        return 0;
+    }
+
+    memAppend( memory, mmu );
+    return 1;
+}
+
+int checkAllocation( struct MMU *mmu, struct Memory *memory, CfgData *data )
 {
     struct Memory *currentBlock = memory->next;
 
-    if( currentBlock == NULL && mmu->base + mmu->requested <= data->memAvailable )
+    if( mmu->base + mmu->requested > data->memAvailable )
     {
-        memAppend( memory, mmu );
-        return 1;
+        return 0;
     }
 
+    //the new block can't overlap any block the process already has
     while( currentBlock != NULL )
     {
-        if( ( mmu->base < currentBlock->block->base
-            || mmu->base > currentBlock->block->base )
-            && ( mmu->base + mmu->requested <= currentBlock->block->base
-            || mmu->base + mmu->requested >= currentBlock->block->base + currentBlock->block->requested )
-            && currentBlock->block->base + mmu->requested <= data->memAvailable )
-            {
-                continue;
-            }
-            else
-            {
-                return 0;
-            }
+        if( mmu->base < currentBlock->block->base + currentBlock->block->requested
+            && currentBlock->block->base < mmu->base + mmu->requested )
+        {
+            return 0;
+        }
         currentBlock = currentBlock->next;
     }
+
     return 1;
 }
 
 int accessMem( struct MMU *mmu, struct Memory *memory, CfgData *data )
+{
+    return findBlock( mmu, memory, data ) != NULL;
+}
+
+struct MMU *findBlock( struct MMU *mmu, struct Memory *memory, CfgData *data )
 {
     struct Memory *currentBlock = memory->next;
 
-    if( currentBlock == NULL )
+    //the access has to fall inside one of the process's blocks
+    while( currentBlock != NULL )
     {
-        return 0;
+        if( mmu->base >= currentBlock->block->base
+            && mmu->base + mmu->requested <= currentBlock->block->base + currentBlock->block->requested
+            && mmu->base + mmu->requested <= data->memAvailable )
+        {
+            return currentBlock->block;
+        }
+        currentBlock = currentBlock->next;
     }
+    return NULL;
+}
 
-    while( currentBlock != NULL )
+
+
+static long long runCpuSlice( struct SimContext *context, int processIndex,
+    long long limit )
+{
+    struct pcb *process = &context->pcbArray[processIndex];
+    CfgData *data = context->data;
+    long long slice = limit;
+    long long quantum = context->scheduler->quantum( context->schedulerState,
+        processIndex );
+    long long next = devicesNextCompletion();
+    long long cycleTime = data->procCycleTime * 1000LL;
+
+    //a slice ends at the quantum or the next device interrupt
+    if( quantum > 0 && quantum < slice )
     {
-        if( ( mmu->base >= currentBlock->block->base && mmu->base
-            < currentBlock->block->base + currentBlock->block->requested )
-            && ( mmu->base + mmu->requested >= currentBlock->block->base
-            && mmu->base + mmu->requested < currentBlock->block->base + currentBlock->block->requested )
-            && mmu->base + mmu->requested <= data->memAvailable )
+        slice = quantum;
+    }
+    if( next != DEVICE_IDLE )
+    {
+        long long untilNext = ( next - simulatedTime()
+            + cycleTime - 1 ) / cycleTime;
+        if( untilNext < 1 )
+        {
+            untilNext = 1;
+        }
+        if( untilNext < slice )
+        {
+            slice = untilNext;
+        }
+    }
+
+    runUntil( context, simulatedTime() + slice * cycleTime );
+    dispatchCostRecordCpu( slice * cycleTime );
+    process->processCycle -= slice;
+    process->remainingTime -= slice * data->procCycleTime;
+    return slice;
+}
+
+static void logFusedOp( struct SimContext *context, struct SimEvent *event,
+    int type, long long cycles )
+{
+    event->type = type;
+    event->value = cycles;
+    logEvent( event, context->data, context->logFile, context->logLine,
+        context->timeBuffer );
+}
+
+static int runFusedCpu( struct SimContext *context, int processIndex,
+    struct SimEvent *event )
+{
+    struct pcb *process = &context->pcbArray[processIndex];
+    const struct MetaOp *op = process->metaDataPointer;
+    const struct MetaOp *source = process->program->sourceOps + op->source;
+    int verbose = coalesceVerbose();
+    long long done = op->cycles - process->processCycle;
+    int index = 0;
+
+    //find the file op the process stopped in, a fresh start logs any
+    //empty ops in front of it
+    while( index < op->count - 1 && done >= source[index].cycles )
+    {
+        if( verbose && done == 0 )
+        {
+            logFusedOp( context, event, EVENT_OP_START, 0 );
+            logFusedOp( context, event, EVENT_OP_END, 0 );
+        }
+        done -= source[index].cycles;
+        index++;
+    }
+
+    long long left = source[index].cycles - done;
+    logFusedOp( context, event, EVENT_OP_START,
+        verbose ? left : process->processCycle );
+
+    //slices also end where a file op ends, and like separate ops there
+    //is no preemption between them
+    while( process->processCycle > 0 )
+    {
+        long long slice = runCpuSlice( context, processIndex,
+            left < process->processCycle ? left : process->processCycle );
+        int preempt = context->scheduler->onTick( context->schedulerState,
+            processIndex, slice );
+
+        left -= slice;
+        if( left == 0 && index < op->count - 1 )
+        {
+            if( verbose )
             {
-                continue;
+                logFusedOp( context, event, EVENT_OP_END, event->value );
             }
-            else
+            index++;
+            while( index < op->count - 1 && source[index].cycles == 0 )
             {
-                return 0;
+                if( verbose )
+                {
+                    logFusedOp( context, event, EVENT_OP_START, 0 );
+                    logFusedOp( context, event, EVENT_OP_END, 0 );
+                }
+                index++;
             }
-        currentBlock = currentBlock->next;
-    }
-    return 1;
-}
+            if( verbose )
+            {
+                logFusedOp( context, event, EVENT_OP_START,
+                    source[index].cycles );
+            }
+            left = source[index].cycles;
+            continue;
+        }
 
+        if( preempt && process->processCycle > 0 )
+        {
+            return OP_PREEMPTED;
+        }
+    }
 
+    logFusedOp( context, event, EVENT_OP_END, event->value );
+    return OP_DONE;
+}
 
-int processPcbLine( CfgData *data, struct pcb *process, struct Memory *memory,
-     char *stringTime, char *logLine, struct LogFile *logFile )
+static int runFusedIo( struct SimContext *context, int processIndex,
+    struct SimEvent *event, int device )
 {
-    char opCode = *(char*)process->metaDataPointer->data[0];
-    char *opString = (char*)process->metaDataPointer->data[1];
-    int logTo = data->logTo;
-    int ioWait = data->ioCycleTime * process->processCycle;
-    int procWait = data->procCycleTime * process->processCycle;
-
+    struct pcb *process = &context->pcbArray[processIndex];
+    const struct MetaOp *op = process->metaDataPointer;
+    const struct MetaOp *source = process->program->sourceOps + op->source;
+    long long cycleTime = deviceCycleTime( context->data, op->opCode ) * 1000LL;
+    long long boundary = simulatedTime();
+    int last = op->count - 1;
+
+    //one request for the run, the file ops end inside it one after another
+    logFusedOp( context, event, EVENT_OP_START, source[0].cycles );
+    deviceSubmit( device, processIndex, 0, op->cycles * cycleTime, boundary );
+    for( int index = 0; index < last; index++ )
+    {
+        boundary += source[index].cycles * cycleTime;
+        runUntil( context, boundary );
+        logFusedOp( context, event, EVENT_OP_END, source[index].cycles );
+        logFusedOp( context, event, EVENT_OP_START, source[index + 1].cycles );
+    }
 
-    pthread_t thread1;
+    //completeIo logs the last end and charges the last op's cycles
+    process->remainingTime -= ( op->cycles - source[last].cycles ) *
+        deviceCycleTime( context->data, op->opCode );
+    process->processCycle = source[last].cycles;
+    runUntil( context, devicesNextCompletion() );
+    return OP_DONE;
+}
 
-    switch( opCode )
+int processPcbLine( struct SimContext *context, int processIndex )
+{
+    struct pcb *process = &context->pcbArray[processIndex];
+    CfgData *data = context->data;
+    char component = process->metaDataPointer->component;
+    int opCode = process->metaDataPointer->opCode;
+    long long ioWait = deviceCycleTime( data, opCode ) * process->processCycle;
+    int device = deviceClass( opCode );
+    struct SimEvent event = { EVENT_OP_START, process->processCounter, component,
+                              opCode, process->processCycle,
+                              0, NULL };
+
+    switch( component )
     {
         case 'M':;
             struct MMU *mmu = processMemoryRequest( process );
-            logLine = clearArray( logLine );
-            if( compareString( opString, "allocate" ) == 1 )
+            event.type = EVENT_MMU_START;
+            if( opCode == OP_ALLOCATE )
             {
-                sprintf( logLine, "Time:  %f, Process %d, MMU Allocation: %d/%d/%d start \n",
-                    accessTimer( 1, stringTime ),
-                    process->processCounter,
-                    mmu->segment,
-                    mmu->base,
-                    mmu->requested );
-                addLineToLogFile( logLine, logFile, logTo );
-                logLine = clearArray( logLine );
-
-                if( allocateMem( mmu, memory, data ) == 1 )
+                logEvent( &event, data, context->logFile, context->logLine,
+                    context->timeBuffer );
+                event.type = EVENT_MMU_RESULT;
+
+                //with swapping, memory is shared and other blocks make room,
+                //but only for a block that is going to be allocated
+                if( !checkAllocation( mmu, process->memory, data ) )
+                {
+                    event.value = 0;
+                }
+                else if( swapEnabled() && !swapMakeRoom( context, processIndex,
+                    mmu->requested ) )
                 {
-                    sprintf( logLine, "Time:  %f, Process %d, MMU Allocation: Successful\n",
-                        accessTimer( 1, stringTime ),
-                        process->processCounter );
-                    addLineToLogFile( logLine, logFile, logTo );
-                    logLine = clearArray( logLine );
-                    return 1;
+                    event.value = 0;
                 }
                 else
                 {
-                    sprintf( logLine, "Time:  %f, Process %d, MMU Allocation: Failed\n",
-                        accessTimer( 1, stringTime ),
-                        process->processCounter );
-                    addLineToLogFile( logLine, logFile, logTo );
-                    logLine = clearArray( logLine );
-                    return 0;
+                    event.value = allocateMem( mmu, process->memory, data );
                 }
-            }
-            else if( compareString( opString, "access" ) == 1 )
-            {
-                sprintf( logLine, "Time:  %f, Process %d, MMU Access: %d/%d/%d start \n",
-                    accessTimer( 1, stringTime ),
-                    process->processCounter,
-                    mmu->segment,
-                    mmu->base,
-                    mmu->requested );
-                addLineToLogFile( logLine, logFile, logTo );
-                logLine = clearArray( logLine );
-                if( accessMem( mmu, memory, data ) == 1 )
+
+                if( event.value == 1 )
                 {
-                    sprintf( logLine, "Time:  %f, Process %d, MMU Access: Successful\n",
-                        accessTimer( 1, stringTime ),
-                        process->processCounter );
-                    addLineToLogFile( logLine, logFile, logTo );
-                    logLine = clearArray( logLine );
-                    free(mmu);
-                    return 1;
+                    swapResident( mmu );
                 }
                 else
                 {
-                    sprintf( logLine, "Time:  %f, Process %d, MMU Access: Failed\n",
-                        accessTimer( 1, stringTime ),
-                        process->processCounter );
-                    addLineToLogFile( logLine, logFile, logTo );
-                    logLine = clearArray( logLine );
                     free( mmu );
-                    return 0;
                 }
+                logEvent( &event, data, context->logFile, context->logLine,
+                    context->timeBuffer );
+                return event.value;
             }
+            else if( opCode == OP_ACCESS )
+            {
+                logEvent( &event, data, context->logFile, context->logLine,
+                    context->timeBuffer );
+                event.type = EVENT_MMU_RESULT;
+                struct MMU *block = findBlock( mmu, process->memory, data );
+                event.value = block != NULL;
+
+                //a swapped out block has to come back in first
+                if( event.value == 1 && swapEnabled() )
+                {
+                    event.value = swapTouch( context, processIndex, block );
+                }
 
-        case 'I':
-            logLine = clearArray( logLine );
-            sprintf( logLine, "Time:  %f, Process %d, %s input start \n",
-                accessTimer( 1, stringTime ),
-                process->processCounter,
-                opString );
-            addLineToLogFile( logLine, logFile, logTo );
-            logLine = clearArray( logLine );
-            pthread_create( &thread1, NULL, *thread, &ioWait );
-            pthread_join( thread1, NULL );
-            sprintf( logLine, "Time:  %f, Process %d, %s input end \n",
-                accessTimer( 1, stringTime ),
-                process->processCounter,
-                opString );
-            addLineToLogFile( logLine, logFile, logTo );
-            logLine = clearArray( logLine );
-            return 1;
+                //charge the access through the cache model, addresses are in KB
+                if( event.value == 1 && cacheEnabled() )
+                {
+                    long long address = ( mmu->segment * 1000LL + mmu->base ) * 1024;
+                    runUntil( context, simulatedTime() + cacheAccess(
+                        mmu->processId, address, mmu->requested * 1024LL ) );
+                }
+                logEvent( &event, data, context->logFile, context->logLine,
+                    context->timeBuffer );
+                free( mmu );
+                return event.value;
+            }
+            free( mmu );
+            return OP_FAILED;
 
+        case 'I':
         case 'O':
-            logLine = clearArray( logLine );
-            sprintf( (char*)logLine, "Time:  %f, Process %d, %s output start \n",
-                accessTimer( 1, stringTime ),
-                process->processCounter,
-                opString );
-            addLineToLogFile( logLine, logFile, logTo );
-            logLine = clearArray( logLine );
-            pthread_create( &thread1, NULL, *thread, &ioWait );
-            pthread_join( thread1, NULL );
-            sprintf( (char*)logLine, "Time:  %f, Process %d, %s output end \n",
-                accessTimer( 1, stringTime ),
-                process->processCounter,
-                opString );
-            addLineToLogFile( logLine, logFile, logTo );
-            logLine = clearArray( logLine );
-            return 1;
+            if( device < 0 )
+            {
+                return OP_FAILED;
+            }
+            if( process->metaDataPointer->count > 1 && coalesceVerbose() )
+            {
+                return runFusedIo( context, processIndex, &event, device );
+            }
+            logEvent( &event, data, context->logFile, context->logLine,
+                context->timeBuffer );
+            deviceSubmit( device, processIndex, 0, ioWait * 1000, simulatedTime() );
+
+            if( context->scheduler->preemptive )
+            {
+                return OP_BLOCKED;
+            }
+
+            //hold the cpu until the device is done, it logs the end
+            runUntil( context, devicesNextCompletion() );
+            return OP_DONE;
 
         case 'P':
-            logLine = clearArray( logLine );
-            sprintf( logLine, "Time:  %f, Process %d, %s operation start \n",
-                accessTimer( 1, stringTime ),
-                process->processCounter,
-                opString );
-            addLineToLogFile(logLine, logFile, logTo);
-            logLine = clearArray( logLine );
-            runTimer( procWait );
-            sprintf( logLine, "Time:  %f, Process %d, %s operation end \n",
-                accessTimer(1, stringTime),
-                process->processCounter,
-                opString );
-            addLineToLogFile(logLine, logFile, logTo);
-            logLine = clearArray( logLine );
-            return 1;
+            if( process->metaDataPointer->count > 1 )
+            {
+                return runFusedCpu( context, processIndex, &event );
+            }
+            logEvent( &event, data, context->logFile, context->logLine,
+                context->timeBuffer );
 
-        default:
-            return 0;
-    }
-}
+            //run in slices that end at the quantum or the next device
+            //interrupt, so the scheduler can preempt in between
+            while( process->processCycle > 0 )
+            {
+                long long slice = runCpuSlice( context, processIndex,
+                    process->processCycle );
 
-int estimatePcbTime( struct LinkedList *metaDataPointer, CfgData *data )
-{
-    while( *(char*)metaDataPointer->data[0] == 'A' )
-    {
-        metaDataPointer = metaDataPointer->next;
-    }
+                if( context->scheduler->onTick( context->schedulerState,
+                    processIndex, slice ) && process->processCycle > 0 )
+                {
+                    return OP_PREEMPTED;
+                }
+            }
 
-    int timeEstimate = 0;
-    while( metaDataPointer != NULL && *(char*)metaDataPointer->data[0] != 'A' )
-    {
-        if( *(char*)metaDataPointer->data[0] == 'I' || *(char*)metaDataPointer->data[0] == 'O' )
-        {
-            timeEstimate += ( *(int*)metaDataPointer->data[2]*data->ioCycleTime );
-        }
-        else if( *(char*)metaDataPointer->data[0] == 'P' )
-        {
-            timeEstimate += ( *(int*)metaDataPointer->data[2]*data->procCycleTime );
-        }
+            event.type = EVENT_OP_END;
+            logEvent( &event, data, context->logFile, context->logLine,
+                context->timeBuffer );
+            return OP_DONE;
 
-        metaDataPointer = metaDataPointer->next;
+        default:
+            return OP_FAILED;
     }
-
-    return timeEstimate;
 }
 
-void *thread( void *ptr )
+long long estimatePcbTime( const struct ProcessIndex *program, CfgData *data )
 {
-    runTimer( *(int*)ptr );
-    return ptr;
+    return program->procCycles * data->procCycleTime +
+           deviceIoTime( data, program->ioCycles, program->deviceCycles );
 }
 
 char *clearArray( char *arrayToClear )
@@ -486,8 +755,18 @@ void deallocateBuffers( char *timeBuffer, char *logLine )
     free(logLine);
 }
 
-void deallocatePcb( struct pcb *pcbArray )
+void releasePcb( struct pcb *process )
+{
+    free( process->repeats );
+    process->repeats = NULL;
+}
+
+void deallocatePcb( struct pcb *pcbArray, int arraySize )
 {
+    for( int processCount = 0; processCount < arraySize; processCount++ )
+    {
+        releasePcb( &pcbArray[processCount] );
+    }
     free( pcbArray );
 }
 
@@ -23,48 +23,114 @@
 #include "LinkedList.h"
 #include "InputDataProcessor.h"
 #include "simtimer.h"
+#include "SimEvent.h"
+#include "LogSink.h"
+#include "Device.h"
+#include "Scheduler.h"
+#include "EventTrace.h"
+#include "ChromeTrace.h"
+#include "OpStats.h"
+#include "Cache.h"
+#include "Swap.h"
+#include "Admission.h"
+#include "LiveStats.h"
+#include "ProcessState.h"
+#include "DispatchCost.h"
+#include "Coalesce.h"
+#include "Profiler.h"
 
 
+// Repeat group the cursor of a process is in
+//      body is the first op after the R(start), remaining the number of
+//      times the group still has to run, this time included.
+struct RepeatFrame
+{
+    const struct MetaOp *body;
+    long long remaining;
+};
+
 // Struct declaration
+//      state is the PROCESS_STATES value, -1 until the process is added to
+//      the state machine. statePrev and stateNext link the processes in the
+//      same state, see ProcessState.h. repeats holds the repeatDepth groups
+//      metaDataPointer is in, innermost last. It is only allocated for
+//      programs with groups, as deep as they nest, and is NULL otherwise.
 struct pcb
 {
-    struct LinkedList *metaDataPointer;
+    const struct ProcessIndex *program;
+    const struct MetaOp *metaDataPointer;
+    struct RepeatFrame *repeats;
+    int repeatDepth;
     int processCounter;
-    int processCycle;
-    char *processState;
+    long long processCycle;
+    int state;
+    int statePrev;
+    int stateNext;
+    struct Memory *memory;
+    long long remainingTime;
+};
+
+// Results of running one op
+enum OP_RESULTS { OP_FAILED, OP_DONE, OP_BLOCKED, OP_PREEMPTED };
+
+// State shared by the dispatch loop and the op handlers for one run
+//      The ready processes are kept by the scheduling policy, in
+//      schedulerState.
+struct SimContext
+{
+    struct pcb *pcbArray;
+    int arraySize;
+    CfgData *data;
+    struct LogFile *logFile;
+    char *logLine;
+    char *timeBuffer;
+    const struct SchedulerOps *scheduler;
+    void *schedulerState;
 };
 
+//resident and lastUse are only used when swapping
 struct MMU
 {
     int processId;
     int segment;
     int base;
     int requested;
+    int resident;
+    long long lastUse;
 };
 
+
 // Function headers
 
-int getNumStartSymbols( struct LinkedList *head );
-struct pcb *storePcb( struct LinkedList *metaData, CfgData *data );
-struct pcb *reorderSJF( struct pcb *pcbArray, CfgData *data, int arraySize );
+struct pcb *storePcb( struct MetaData *metaData, CfgData *data );
+void initPcb( struct pcb *process, struct MetaData *metaData, int program,
+    int processCounter, CfgData *data );
 struct LogFile *processPcbArray( struct pcb *pcbArrayPointer, CfgData *data, int arraySize );
-void startOperatingSystemOps(char *timeBuffer, struct LogFile *logFile, char *logLine, int logTo);
+void startOperatingSystemOps(char *timeBuffer, struct LogFile *logFile, char *logLine, CfgData *data);
 void setPcbArrayToReady( struct pcb *pcbArray, int arrayLength,
-    struct LogFile *logFile, char *logLine, int logTo, char *timeBuffer );
-void endOperatingSystemOps(char *timeBuffer, struct LogFile *logFile, char *logLine, int logTo);
+    struct LogFile *logFile, char *logLine, CfgData *data, char *timeBuffer );
+void endOperatingSystemOps(char *timeBuffer, struct LogFile *logFile, char *logLine, CfgData *data);
+void logStateChange( struct pcb *process, int state, CfgData *data,
+    struct LogFile *logFile, char *logLine, char *timeBuffer );
+void logEvent( struct SimEvent *event, CfgData *data, struct LogFile *logFile,
+    char *logLine, char *timeBuffer );
 void updatePointerAndCycle(struct pcb *pcbArrayPointer, int processNumber);
-void addLineToLogFile(char *line, struct LogFile *listHead, int logTo);
 void createLogFile( struct LogFile *listHead, char *logPath );
 struct MMU *processMemoryRequest( struct pcb *memReq );
 int allocateMem( struct MMU *mmu, struct Memory *memory, CfgData *data );
+int checkAllocation( struct MMU *mmu, struct Memory *memory, CfgData *data );
 int accessMem( struct MMU *mmu, struct Memory *memory, CfgData *data );
-int processPcbLine( CfgData *data, struct pcb *process, struct Memory *memory,
-     char *stringTime, char *logLine, struct LogFile *logFile );
-int estimatePcbTime(struct LinkedList *metaDataPointer, CfgData *data);
-void *thread( void *ptr );
+struct MMU *findBlock( struct MMU *mmu, struct Memory *memory, CfgData *data );
+int processPcbLine( struct SimContext *context, int processIndex );
+int runProcess( struct SimContext *context, int processIndex );
+int dispatchProcess( struct SimContext *context, int processIndex );
+void runUntil( struct SimContext *context, long long target );
+void completeIo( struct SimContext *context, int processIndex );
+long long estimatePcbTime( const struct ProcessIndex *program, CfgData *data );
 char *clearArray( char *arrayToClear );
 void deallocateBuffers( char *timeBuffer, char *logLine );
-void deallocatePcb( struct pcb *pcbArray );
+void releasePcb( struct pcb *process );
+void deallocatePcb( struct pcb *pcbArray, int arraySize );
 void deallocateLogFile( struct LogFile *listHead );
 void deallocateMemoryList( struct Memory *listHead );
 
@@ -0,0 +1,254 @@
+/**
+ * Name:
+ *      ProcessState.c
+ *
+ * Desc:
+ *      Implementation of ProcessState.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      There is one state machine per run, kept in this file the same way
+ *      Device.c keeps its devices. The queues are intrusive, a process is
+ *      linked through statePrev and stateNext in its own pcb, so moving a
+ *      process never allocates. Each queue keeps the order processes
+ *      entered the state.
+ */
+
+// Include guard
+#ifndef PROCESSSTATE_C
+#define PROCESSSTATE_C
+
+// Include header
+#include "ProcessState.h"
+#include "ProcessPcb.h"
+
+// Legal moves, indexed [from][to]
+//      Running to Ready is a preemption, Waiting to Ready an I/O that
+//      finished while another process had the CPU.
+static const int LEGAL_TRANSITIONS[STATE_COUNT][STATE_COUNT] = {
+    //                New Ready Running Waiting Exit
+    /* New     */   {  0,   1,     0,      0,    0 },
+    /* Ready   */   {  0,   0,     1,      0,    0 },
+    /* Running */   {  0,   1,     0,      1,    1 },
+    /* Waiting */   {  0,   1,     0,      0,    0 },
+    /* Exit    */   {  0,   0,     0,      0,    0 } };
+
+// State machine
+static struct pcb *statePcbs = NULL;
+static struct StateQueue stateQueues[STATE_COUNT];
+
+// Statistics
+static long long transitions[STATE_COUNT][STATE_COUNT];
+static long long illegalTransitions = 0;
+
+static void stateLink( int processIndex, int state )
+{
+    /**
+     * Desc:
+     *      Put a process at the back of a state queue.
+     *
+     * Args:
+     *      processIndex (int): index of a process that is on no queue
+     *      state (int): PROCESS_STATES value of the queue
+     */
+    struct StateQueue *queue = &stateQueues[state];
+    struct pcb *process = &statePcbs[processIndex];
+
+    process->state = state;
+    process->statePrev = queue->tail;
+    process->stateNext = -1;
+
+    if( ( queue->tail ) >= ( 0 ) )
+    {
+        statePcbs[queue->tail].stateNext = processIndex;
+    }
+    else
+    {
+        queue->head = processIndex;
+    }
+
+    queue->tail = processIndex;
+    queue->count++;
+}
+
+static void stateUnlink( int processIndex )
+{
+    /**
+     * Desc:
+     *      Take a process off the queue of its state.
+     *
+     * Args:
+     *      processIndex (int): index of a process that is on a queue
+     */
+    struct pcb *process = &statePcbs[processIndex];
+    struct StateQueue *queue = &stateQueues[process->state];
+
+    if( ( process->statePrev ) >= ( 0 ) )
+    {
+        statePcbs[process->statePrev].stateNext = process->stateNext;
+    }
+    else
+    {
+        queue->head = process->stateNext;
+    }
+
+    if( ( process->stateNext ) >= ( 0 ) )
+    {
+        statePcbs[process->stateNext].statePrev = process->statePrev;
+    }
+    else
+    {
+        queue->tail = process->statePrev;
+    }
+
+    queue->count--;
+    process->state = -1;
+}
+
+// Begin implementation
+void processStatesStart( struct pcb *pcbArray )
+{
+    /**
+     * Desc:
+     *      Start a run with empty queues and no transitions counted.
+     *
+     * Args:
+     *      pcbArray (struct pcb*): processes of the run
+     */
+    statePcbs = pcbArray;
+    illegalTransitions = 0;
+
+    for( int state = 0; ( state ) < ( STATE_COUNT ); state++ )
+    {
+        stateQueues[state].head = -1;
+        stateQueues[state].tail = -1;
+        stateQueues[state].count = 0;
+
+        for( int next = 0; ( next ) < ( STATE_COUNT ); next++ )
+        {
+            transitions[state][next] = 0;
+        }
+    }
+}
+
+void processStateAdd( struct pcb *process )
+{
+    /**
+     * Desc:
+     *      Put a newly created process in the New state.
+     *
+     * Args:
+     *      process (struct pcb*): process of the run that is on no queue
+     */
+    stateLink( (int) ( process - statePcbs ), STATE_NEW );
+}
+
+int processStateMove( struct pcb *process, int state )
+{
+    /**
+     * Desc:
+     *      Move a process to another state, if the move is legal.
+     *
+     * Args:
+     *      process (struct pcb*): process of the run
+     *      state (int): PROCESS_STATES value to move to
+     *
+     * Returns:
+     *      1 if the process moved, 0 if the move is not legal.
+     */
+    int processIndex = (int) ( process - statePcbs );
+    int from = process->state;
+
+    if( ( from ) < ( 0 ) || ( LEGAL_TRANSITIONS[from][state] ) == ( 0 ) )
+    {
+        illegalTransitions++;
+        fprintf( stderr, "Illegal state change of Process %d: %s to %s\n",
+                 process->processCounter,
+                 from < 0 ? "none" : PROCESS_STATE_NAMES[from],
+                 PROCESS_STATE_NAMES[state] );
+        return 0;
+    }
+
+    stateUnlink( processIndex );
+    stateLink( processIndex, state );
+    transitions[from][state]++;
+    return 1;
+}
+
+void processStateRemove( struct pcb *process )
+{
+    /**
+     * Desc:
+     *      Forget a process, so its pcb can be reused.
+     *
+     * Args:
+     *      process (struct pcb*): process of the run
+     */
+    if( ( process->state ) >= ( 0 ) )
+    {
+        stateUnlink( (int) ( process - statePcbs ) );
+    }
+}
+
+int processStateCount( int state )
+{
+    /**
+     * Desc:
+     *      Number of processes in a state.
+     *
+     * Args:
+     *      state (int): PROCESS_STATES value
+     *
+     * Returns:
+     *      The process count.
+     */
+    return stateQueues[state].count;
+}
+
+int processStateHead( int state )
+{
+    /**
+     * Desc:
+     *      First process that entered a state, follow stateNext in the pcb
+     *      for the rest.
+     *
+     * Args:
+     *      state (int): PROCESS_STATES value
+     *
+     * Returns:
+     *      The process index, or -1 if no process is in the state.
+     */
+    return stateQueues[state].head;
+}
+
+void processStatesPrint( void )
+{
+    /**
+     * Desc:
+     *      Print the transitions taken between every pair of states.
+     */
+    printf( "\n___________STATE STATS___________\n" );
+    printf( "%-10s", "From \\ To" );
+    for( int state = 0; ( state ) < ( STATE_COUNT ); state++ )
+    {
+        printf( " %10s", PROCESS_STATE_NAMES[state] );
+    }
+    printf( "\n" );
+
+    for( int from = 0; ( from ) < ( STATE_COUNT ); from++ )
+    {
+        printf( "%-10s", PROCESS_STATE_NAMES[from] );
+        for( int state = 0; ( state ) < ( STATE_COUNT ); state++ )
+        {
+            printf( " %10lld", transitions[from][state] );
+        }
+        printf( "\n" );
+    }
+
+    printf( "Illegal transitions: %lld\n", illegalTransitions );
+}
+
+// End include guard
+#endif              // PROCESSSTATE_C
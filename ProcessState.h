@@ -0,0 +1,45 @@
+/**
+ * Name:
+ *      ProcessState.h
+ *
+ * Desc:
+ *      Process state machine. Every process is on the queue of its state,
+ *      moves are checked against the legal transitions and counted, and
+ *      the number of processes in a state is known at any time.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef PROCESSSTATE_H
+#define PROCESSSTATE_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "SimEvent.h"
+
+// Forward declaration, the links live in the pcb
+struct pcb;
+
+// Queue of the processes in one state
+//      head and tail are pcb array indexes, -1 when the queue is empty.
+struct StateQueue
+{
+    int head;
+    int tail;
+    int count;
+};
+
+// Function headers
+void processStatesStart( struct pcb *pcbArray );
+void processStateAdd( struct pcb *process );
+int processStateMove( struct pcb *process, int state );
+void processStateRemove( struct pcb *process );
+int processStateCount( int state );
+int processStateHead( int state );
+void processStatesPrint( void );
+
+// End include guard
+#endif              // PROCESSSTATE_H
@@ -0,0 +1,137 @@
+/**
+ * Name:
+ *      Profiler.c
+ *
+ * Desc:
+ *      Implementation of Profiler.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      The profiler is only called from the main thread. Time spent in a
+ *      nested phase is charged to that phase and not to its parent, so the
+ *      self times add up to no more than the run time.
+ */
+
+// Include guard
+#ifndef PROFILER_C
+#define PROFILER_C
+
+// Include header
+#include "Profiler.h"
+
+const char *PROFILE_PHASE_NAMES[] = {"parse", "pcb build", "sched decision",
+                                     "op dispatch", "timer wait",
+                                     "log format", "log append",
+                                     "log flush"};
+
+// Profiler state
+static long long runStartNs = 0;
+static long long phaseCalls[PROFILE_PHASE_COUNT];
+static long long phaseTotalNs[PROFILE_PHASE_COUNT];
+static long long phaseSelfNs[PROFILE_PHASE_COUNT];
+static int stackPhase[PROFILE_MAX_DEPTH];
+static long long stackStartNs[PROFILE_MAX_DEPTH];
+static long long stackChildNs[PROFILE_MAX_DEPTH];
+static int stackDepth = 0;
+
+static long long profileNow( void )
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Begin implementation
+void profileStart( void )
+{
+    /**
+     * Desc:
+     *      Mark the start of the run, percentages are reported against the
+     *      time since this call.
+     */
+    runStartNs = profileNow();
+}
+
+void profileEnter( int phase )
+{
+    /**
+     * Desc:
+     *      Start timing a phase. Must be matched by profileLeave.
+     *
+     * Args:
+     *      phase (int): PROFILE_PHASES code of the phase
+     */
+    if( ( stackDepth ) >= ( PROFILE_MAX_DEPTH ) )
+    {
+        return;
+    }
+
+    stackPhase[stackDepth] = phase;
+    stackChildNs[stackDepth] = 0;
+    stackStartNs[stackDepth] = profileNow();
+    stackDepth++;
+}
+
+void profileLeave( int phase )
+{
+    /**
+     * Desc:
+     *      Stop timing the innermost phase and charge its time.
+     *
+     * Args:
+     *      phase (int): PROFILE_PHASES code of the phase, must match the
+     *                   phase given to the last profileEnter
+     */
+    long long elapsed;
+
+    if( ( stackDepth ) == ( 0 ) || ( stackPhase[stackDepth - 1] ) != ( phase ) )
+    {
+        return;
+    }
+
+    stackDepth--;
+    elapsed = profileNow() - stackStartNs[stackDepth];
+    phaseCalls[phase]++;
+    phaseTotalNs[phase] += elapsed;
+    phaseSelfNs[phase] += elapsed - stackChildNs[stackDepth];
+
+    if( ( stackDepth ) > ( 0 ) )
+    {
+        stackChildNs[stackDepth - 1] += elapsed;
+    }
+}
+
+void profilePrint( void )
+{
+    /**
+     * Desc:
+     *      Print the phase breakdown table to stdout.
+     */
+#ifdef SIM_PROFILE
+    long long runNs = profileNow() - runStartNs;
+
+    printf( "\n___________PROFILE___________\n" );
+    printf( "%-16s %12s %16s %14s %8s\n", "Phase", "Calls", "Total ns",
+            "Mean ns", "Self %" );
+    for( int phase = 0; ( phase ) < ( PROFILE_PHASE_COUNT ); phase++ )
+    {
+        printf( "%-16s %12lld %16lld %14lld %7.2f%%\n",
+                PROFILE_PHASE_NAMES[phase],
+                phaseCalls[phase],
+                phaseTotalNs[phase],
+                phaseCalls[phase] > 0 ? phaseTotalNs[phase] / phaseCalls[phase]
+                                      : 0,
+                runNs > 0 ? 100.0 * phaseSelfNs[phase] / runNs : 0.0 );
+    }
+    printf( "%-16s %12s %16lld\n", "run", "", runNs );
+#else
+    printf( "\nProfiling is not compiled in, "
+            "rebuild with: make -f sim04_mf profile\n" );
+#endif
+}
+
+// End include guard
+#endif              // PROFILER_C
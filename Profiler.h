@@ -0,0 +1,48 @@
+/**
+ * Name:
+ *      Profiler.h
+ *
+ * Desc:
+ *      Optional hot path profiler. Phases are timed with PROFILE_ENTER and
+ *      PROFILE_LEAVE, which only do anything when the simulator is built
+ *      with -DSIM_PROFILE (make -f sim04_mf profile). Otherwise they compile
+ *      to nothing.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Include header
+#include <stdio.h>
+#include <time.h>
+
+// Maximum nesting of profiled phases
+#define PROFILE_MAX_DEPTH 16
+
+// Profiled phases
+enum PROFILE_PHASES { PROFILE_PARSE, PROFILE_PCB_BUILD,
+                      PROFILE_SCHED_DECISION, PROFILE_OP_DISPATCH,
+                      PROFILE_TIMER_WAIT, PROFILE_LOG_FORMAT,
+                      PROFILE_LOG_APPEND, PROFILE_LOG_FLUSH,
+                      PROFILE_PHASE_COUNT };
+
+#ifdef SIM_PROFILE
+#define PROFILE_ENTER( phase ) profileEnter( phase )
+#define PROFILE_LEAVE( phase ) profileLeave( phase )
+#else
+#define PROFILE_ENTER( phase ) ( (void) 0 )
+#define PROFILE_LEAVE( phase ) ( (void) 0 )
+#endif
+
+// Function headers
+void profileStart( void );
+void profileEnter( int phase );
+void profileLeave( int phase );
+void profilePrint( void );
+
+// End include guard
+#endif              // PROFILER_H
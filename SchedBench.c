@@ -0,0 +1,202 @@
+/**
+ * Name:
+ *      SchedBench.c
+ *
+ * Desc:
+ *      Decision latency microbenchmark for the scheduling policies. Fills
+ *      each policy's ready queue with synthetic processes and times every
+ *      enqueue and pickNext call.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Built with "make -f sim04_mf bench". Usage: sim04bench [max ready]
+ *      Each call is timed on its own with CLOCK_MONOTONIC, so the numbers
+ *      include a few tens of ns of clock overhead.
+ */
+
+// Include guard
+#ifndef SCHEDBENCH_C
+#define SCHEDBENCH_C
+
+// Include header
+#include <string.h>
+#include <time.h>
+#include "ProcessPcb.h"
+#include "Scheduler.h"
+
+// Ready set sizes and the number of timed steady state decisions per size
+#define BENCH_MIN_READY     1000
+#define BENCH_MAX_READY     1000000
+#define BENCH_DECISIONS     100000
+
+static long long nowNanoSeconds( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static int compareLatency( const void *first, const void *second )
+{
+    long long a = *(const long long *) first;
+    long long b = *(const long long *) second;
+
+    return ( a > b ) - ( a < b );
+}
+
+static long long percentile( long long *samples, int count, int percent )
+{
+    /**
+     * Desc:
+     *      Percentile of a sorted sample array.
+     *
+     * Args:
+     *      samples (long long*): samples, sorted ascending
+     *      count (int): number of samples
+     *      percent (int): percentile to report, 0 to 100
+     *
+     * Returns:
+     *      The sample at that percentile.
+     */
+    int index = (int) ( (long long) ( count - 1 ) * percent / 100 );
+
+    return samples[index];
+}
+
+static void benchPolicy( int code, CfgData *data, struct pcb *pcbArray,
+                         int readyCount, long long *enqueueTimes,
+                         long long *pickTimes )
+{
+    /**
+     * Desc:
+     *      Fill a policy with readyCount processes, then time a steady
+     *      state of picking a process, running it for a quantum and
+     *      putting it back, and print one row of the results table.
+     *
+     * Args:
+     *      code (int): SCHED_CODES value of the policy
+     *      data (CfgData*): config the policy is created with
+     *      pcbArray (struct pcb*): at least readyCount synthetic processes
+     *      readyCount (int): size of the ready set
+     *      enqueueTimes (long long*): scratch for the enqueue samples
+     *      pickTimes (long long*): scratch for the pickNext samples
+     */
+    const struct SchedulerOps *scheduler = schedulerFor( code );
+    void *state = scheduler->create( data, pcbArray, readyCount );
+    int decisions = readyCount < BENCH_DECISIONS ? readyCount : BENCH_DECISIONS;
+    long long start;
+
+    for( int index = 0; ( index ) < ( readyCount ); index++ )
+    {
+        scheduler->enqueue( state, index );
+    }
+
+    for( int decision = 0; ( decision ) < ( decisions ); decision++ )
+    {
+        int processIndex;
+
+        start = nowNanoSeconds();
+        processIndex = scheduler->pickNext( state );
+        pickTimes[decision] = nowNanoSeconds() - start;
+
+        // Charge a quantum so time based policies reorder the process
+        scheduler->onTick( state, processIndex, data->quantumTimeCycles );
+        pcbArray[processIndex].remainingTime -= data->quantumTimeCycles *
+                                                data->procCycleTime;
+
+        start = nowNanoSeconds();
+        scheduler->enqueue( state, processIndex );
+        enqueueTimes[decision] = nowNanoSeconds() - start;
+    }
+
+    scheduler->destroy( state );
+
+    qsort( enqueueTimes, decisions, sizeof( long long ), compareLatency );
+    qsort( pickTimes, decisions, sizeof( long long ), compareLatency );
+
+    printf( "%-8s %10d %12lld %12lld %12lld %12lld\n", scheduler->name,
+            readyCount, percentile( enqueueTimes, decisions, 50 ),
+            percentile( enqueueTimes, decisions, 99 ),
+            percentile( pickTimes, decisions, 50 ),
+            percentile( pickTimes, decisions, 99 ) );
+}
+
+int main( int argc, char **argv )
+{
+    int maxReady = BENCH_MAX_READY;
+    CfgData data;
+    struct ProcessIndex *programs;
+    struct pcb *pcbArray;
+    long long *enqueueTimes = malloc( sizeof( long long ) * BENCH_DECISIONS );
+    long long *pickTimes = malloc( sizeof( long long ) * BENCH_DECISIONS );
+
+    if( ( argc ) > ( 1 ) )
+    {
+        maxReady = stringToInt( argv[1] );
+    }
+
+    if( ( maxReady ) < ( BENCH_MIN_READY ) )
+    {
+        maxReady = BENCH_MIN_READY;
+    }
+
+    memset( &data, 0, sizeof( data ) );
+    data.quantumTimeCycles = 10;
+    data.procCycleTime = 10;
+    data.ioCycleTime = 20;
+    data.mlfqLevels = MLFQ_DEFAULT_LEVELS;
+    data.mlfqBoostInterval = MLFQ_DEFAULT_BOOST;
+    for( int level = 0; ( level ) < ( data.mlfqLevels ); level++ )
+    {
+        data.mlfqQuanta[level] = data.quantumTimeCycles << level;
+    }
+
+    programs = malloc( sizeof( struct ProcessIndex ) * maxReady );
+    pcbArray = malloc( sizeof( struct pcb ) * maxReady );
+
+    printf( "%-8s %10s %12s %12s %12s %12s\n", "Policy", "Ready",
+            "Enqueue p50", "Enqueue p99", "Pick p50", "Pick p99" );
+    printf( "%-8s %10s %12s %12s %12s %12s\n", "", "", "(ns)", "(ns)",
+            "(ns)", "(ns)" );
+
+    for( int code = 0; ( code ) < ( SCHED_CODE_COUNT ); code++ )
+    {
+        for( int readyCount = BENCH_MIN_READY; ( readyCount ) <= ( maxReady );
+             readyCount *= 10 )
+        {
+            // Same synthetic workload for every policy and size
+            srand( 1 );
+            for( int index = 0; ( index ) < ( readyCount ); index++ )
+            {
+                programs[index].offset = 0;
+                programs[index].opCount = 0;
+                programs[index].repeatDepth = 0;
+                programs[index].procCycles = rand() % 1000;
+                programs[index].ioCycles = rand() % 1000;
+                memset( programs[index].deviceCycles, 0,
+                        sizeof( programs[index].deviceCycles ) );
+                pcbArray[index].program = &programs[index];
+                pcbArray[index].processCounter = index;
+                pcbArray[index].memory = NULL;
+                pcbArray[index].repeats = NULL;
+                pcbArray[index].remainingTime =
+                    estimatePcbTime( &programs[index], &data );
+            }
+
+            benchPolicy( code, &data, pcbArray, readyCount, enqueueTimes,
+                         pickTimes );
+        }
+    }
+
+    free( programs );
+    free( pcbArray );
+    free( enqueueTimes );
+    free( pickTimes );
+    return 0;
+}
+
+// End include guard
+#endif              // SCHEDBENCH_C
@@ -0,0 +1,380 @@
+/**
+ * Name:
+ *      Scheduler.c
+ *
+ * Desc:
+ *      Implementation of Scheduler.h, the policy registry and the FCFS,
+ *      SJF, SRTF and RR policies.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      FCFS and RR share a FIFO ready queue. SJF and SRTF share a binary
+ *      heap keyed by the process time estimate, ties go to the process
+ *      that became ready first.
+ */
+
+// Include guard
+#ifndef SCHEDULER_C
+#define SCHEDULER_C
+
+// Include header
+#include "Scheduler.h"
+#include "ProcessPcb.h"
+
+// Registry, indexed by SCHED_CODES
+static const struct SchedulerOps *SCHEDULERS[] = { &FCFS_N_SCHEDULER,
+                                                   &SJF_N_SCHEDULER,
+                                                   &SRTF_P_SCHEDULER,
+                                                   &FCFS_P_SCHEDULER,
+                                                   &RR_P_SCHEDULER,
+                                                   &MLFQ_SCHEDULER };
+
+// Config names that map onto a registered policy
+struct SchedulerAlias
+{
+    const char *name;
+    int code;
+};
+
+static const struct SchedulerAlias SCHEDULER_ALIASES[] = {
+    { "NONE", SCHED_CODE_FCFS_N },
+    { "SRTF-N", SCHED_CODE_SRTF_P } };
+
+// FIFO ready queue state
+//      queue is a ring buffer of count indexes starting at head, big enough
+//      for every process. used counts the cycles run since the running
+//      process was picked, for the RR quantum.
+struct FifoState
+{
+    int *queue;
+    int capacity;
+    int head;
+    int count;
+    long long quantum;
+    long long used;
+};
+
+// Heap entry, ordered by key then seq
+struct HeapEntry
+{
+    long long key;
+    long long seq;
+    int processIndex;
+};
+
+// Shortest time first state
+//      For SRTF the key is the time the process has left, for SJF it is
+//      the estimate of the whole process.
+struct HeapState
+{
+    struct HeapEntry *heap;
+    int count;
+    long long nextSeq;
+    struct pcb *pcbArray;
+    CfgData *data;
+    int remaining;
+};
+
+static void *fifoCreate( CfgData *data, struct pcb *pcbArray, int arraySize )
+{
+    struct FifoState *state = malloc( sizeof( struct FifoState ) );
+
+    (void) pcbArray;
+    state->capacity = arraySize > 0 ? arraySize : 1;
+    state->queue = malloc( sizeof( int ) * state->capacity );
+    state->head = 0;
+    state->count = 0;
+    state->quantum = data->quantumTimeCycles;
+    state->used = 0;
+    return state;
+}
+
+static void fifoDestroy( void *state )
+{
+    struct FifoState *fifo = state;
+
+    free( fifo->queue );
+    free( fifo );
+}
+
+static void fifoEnqueue( void *state, int processIndex )
+{
+    struct FifoState *fifo = state;
+
+    fifo->queue[( fifo->head + fifo->count ) % fifo->capacity] = processIndex;
+    fifo->count++;
+}
+
+static int fifoPickNext( void *state )
+{
+    struct FifoState *fifo = state;
+    int processIndex;
+
+    if( ( fifo->count ) == ( 0 ) )
+    {
+        return -1;
+    }
+
+    processIndex = fifo->queue[fifo->head];
+    fifo->head = ( fifo->head + 1 ) % fifo->capacity;
+    fifo->count--;
+    fifo->used = 0;
+    return processIndex;
+}
+
+static long long noQuantum( void *state, int processIndex )
+{
+    (void) state;
+    (void) processIndex;
+    return 0;
+}
+
+static int neverPreempt( void *state, int processIndex, long long cycles )
+{
+    (void) state;
+    (void) processIndex;
+    (void) cycles;
+    return 0;
+}
+
+static void ignoreBlock( void *state, int processIndex )
+{
+    (void) state;
+    (void) processIndex;
+}
+
+static long long rrQuantum( void *state, int processIndex )
+{
+    struct FifoState *fifo = state;
+
+    (void) processIndex;
+    return fifo->quantum - fifo->used;
+}
+
+static int rrOnTick( void *state, int processIndex, long long cycles )
+{
+    struct FifoState *fifo = state;
+
+    (void) processIndex;
+    fifo->used += cycles;
+    return fifo->used >= fifo->quantum;
+}
+
+static int heapBefore( const struct HeapEntry *first,
+                       const struct HeapEntry *second )
+{
+    return first->key < second->key ||
+           ( first->key == second->key && first->seq < second->seq );
+}
+
+static void *heapCreate( CfgData *data, struct pcb *pcbArray, int arraySize,
+                         int remaining )
+{
+    struct HeapState *state = malloc( sizeof( struct HeapState ) );
+
+    state->heap = malloc( sizeof( struct HeapEntry ) *
+                          ( arraySize > 0 ? arraySize : 1 ) );
+    state->count = 0;
+    state->nextSeq = 0;
+    state->pcbArray = pcbArray;
+    state->data = data;
+    state->remaining = remaining;
+    return state;
+}
+
+static void *sjfCreate( CfgData *data, struct pcb *pcbArray, int arraySize )
+{
+    return heapCreate( data, pcbArray, arraySize, 0 );
+}
+
+static void *srtfCreate( CfgData *data, struct pcb *pcbArray, int arraySize )
+{
+    return heapCreate( data, pcbArray, arraySize, 1 );
+}
+
+static void heapDestroy( void *state )
+{
+    struct HeapState *shortest = state;
+
+    free( shortest->heap );
+    free( shortest );
+}
+
+static void heapEnqueue( void *state, int processIndex )
+{
+    struct HeapState *shortest = state;
+    struct pcb *process = &shortest->pcbArray[processIndex];
+    struct HeapEntry entry = { estimatePcbTime( process->program,
+                                                shortest->data ),
+                               shortest->nextSeq++, processIndex };
+    int child = shortest->count++;
+
+    if( shortest->remaining )
+    {
+        entry.key = process->remainingTime;
+    }
+
+    // Sift up
+    while( ( child ) > ( 0 ) )
+    {
+        int parent = ( child - 1 ) / 2;
+
+        if( !heapBefore( &entry, &shortest->heap[parent] ) )
+        {
+            break;
+        }
+
+        shortest->heap[child] = shortest->heap[parent];
+        child = parent;
+    }
+
+    shortest->heap[child] = entry;
+}
+
+static int heapPickNext( void *state )
+{
+    struct HeapState *shortest = state;
+    struct HeapEntry last;
+    int processIndex;
+    int parent = 0;
+
+    if( ( shortest->count ) == ( 0 ) )
+    {
+        return -1;
+    }
+
+    processIndex = shortest->heap[0].processIndex;
+    last = shortest->heap[--shortest->count];
+
+    // Sift the last entry down from the root
+    while( 1 )
+    {
+        int child = parent * 2 + 1;
+
+        if( ( child ) >= ( shortest->count ) )
+        {
+            break;
+        }
+
+        if( ( child + 1 ) < ( shortest->count ) &&
+            heapBefore( &shortest->heap[child + 1], &shortest->heap[child] ) )
+        {
+            child++;
+        }
+
+        if( !heapBefore( &shortest->heap[child], &last ) )
+        {
+            break;
+        }
+
+        shortest->heap[parent] = shortest->heap[child];
+        parent = child;
+    }
+
+    shortest->heap[parent] = last;
+    return processIndex;
+}
+
+static int srtfOnTick( void *state, int processIndex, long long cycles )
+{
+    struct HeapState *shortest = state;
+
+    // Preempt when a ready process has less time left than the running one
+    (void) cycles;
+    return shortest->count > 0 && shortest->heap[0].key <
+           shortest->pcbArray[processIndex].remainingTime;
+}
+
+const struct SchedulerOps FCFS_N_SCHEDULER = { "FCFS-N", 0, fifoCreate,
+    fifoDestroy, fifoEnqueue, fifoPickNext, noQuantum, neverPreempt,
+    ignoreBlock, fifoEnqueue };
+
+const struct SchedulerOps SJF_N_SCHEDULER = { "SJF-N", 0, sjfCreate,
+    heapDestroy, heapEnqueue, heapPickNext, noQuantum, neverPreempt,
+    ignoreBlock, heapEnqueue };
+
+const struct SchedulerOps SRTF_P_SCHEDULER = { "SRTF-P", 1, srtfCreate,
+    heapDestroy, heapEnqueue, heapPickNext, noQuantum, srtfOnTick,
+    ignoreBlock, heapEnqueue };
+
+const struct SchedulerOps FCFS_P_SCHEDULER = { "FCFS-P", 1, fifoCreate,
+    fifoDestroy, fifoEnqueue, fifoPickNext, noQuantum, neverPreempt,
+    ignoreBlock, fifoEnqueue };
+
+const struct SchedulerOps RR_P_SCHEDULER = { "RR-P", 1, fifoCreate,
+    fifoDestroy, fifoEnqueue, fifoPickNext, rrQuantum, rrOnTick,
+    ignoreBlock, fifoEnqueue };
+
+// Begin implementation
+const struct SchedulerOps *schedulerFor( int code )
+{
+    /**
+     * Desc:
+     *      Look up a registered policy.
+     *
+     * Args:
+     *      code (int): SCHED_CODES value
+     *
+     * Returns:
+     *      The policy, FCFS-N if the code is not registered.
+     */
+    if( ( code ) < ( 0 ) || ( code ) >= ( SCHED_CODE_COUNT ) )
+    {
+        return SCHEDULERS[SCHED_CODE_FCFS_N];
+    }
+
+    return SCHEDULERS[code];
+}
+
+const char *schedulerName( int code )
+{
+    /**
+     * Desc:
+     *      Config name of a scheduling code, as printed in the log.
+     *
+     * Args:
+     *      code (int): SCHED_CODES value
+     *
+     * Returns:
+     *      The policy name.
+     */
+    return schedulerFor( code )->name;
+}
+
+int schedulerCode( const char *name )
+{
+    /**
+     * Desc:
+     *      Look up a scheduling code by its config name.
+     *
+     * Args:
+     *      name (const char*): name from the config, e.g. "RR-P"
+     *
+     * Returns:
+     *      The SCHED_CODES value, or -1 if no policy has that name.
+     */
+    for( int code = 0; ( code ) < ( SCHED_CODE_COUNT ); code++ )
+    {
+        if( ( compareString( name, SCHEDULERS[code]->name ) ) == ( 1 ) )
+        {
+            return code;
+        }
+    }
+
+    for( size_t alias = 0; ( alias ) < ( sizeof( SCHEDULER_ALIASES ) /
+                                         sizeof( SCHEDULER_ALIASES[0] ) );
+         alias++ )
+    {
+        if( ( compareString( name, SCHEDULER_ALIASES[alias].name ) ) == ( 1 ) )
+        {
+            return SCHEDULER_ALIASES[alias].code;
+        }
+    }
+
+    return -1;
+}
+
+// End include guard
+#endif              // SCHEDULER_C
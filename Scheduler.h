@@ -0,0 +1,70 @@
+/**
+ * Name:
+ *      Scheduler.h
+ *
+ * Desc:
+ *      Pluggable CPU scheduling policies. Each policy fills in a
+ *      SchedulerOps table and is registered under its config name in
+ *      Scheduler.c, the dispatch loop only talks to the table.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+// Scheduling codes, in the same order as the registry in Scheduler.c
+enum SCHED_CODES { SCHED_CODE_FCFS_N, SCHED_CODE_SJF_N, SCHED_CODE_SRTF_P,
+                   SCHED_CODE_FCFS_P, SCHED_CODE_RR_P, SCHED_CODE_MLFQ,
+                   SCHED_CODE_COUNT };
+
+// Include header
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+struct pcb;
+
+// Scheduling policy
+//      Processes are named by their index in the pcb array. Every callback
+//      gets the state returned by create.
+//          enqueue:  a new or preempted process is ready
+//          pickNext: remove and return the next process to run, -1 if none
+//          quantum:  cycles the running process may run before the next
+//                    onTick, 0 for no limit
+//          onTick:   the running process ran cycles processor cycles,
+//                    return 1 to preempt it
+//          onBlock:  the running process is waiting on a device
+//          onWakeup: a waiting process finished its I/O and is ready
+//      Preemptive policies give up the cpu while a process waits on a
+//      device, the others hold it until the I/O is done.
+struct SchedulerOps
+{
+    const char *name;
+    int preemptive;
+    void *( *create )( CfgData *data, struct pcb *pcbArray, int arraySize );
+    void ( *destroy )( void *state );
+    void ( *enqueue )( void *state, int processIndex );
+    int ( *pickNext )( void *state );
+    long long ( *quantum )( void *state, int processIndex );
+    int ( *onTick )( void *state, int processIndex, long long cycles );
+    void ( *onBlock )( void *state, int processIndex );
+    void ( *onWakeup )( void *state, int processIndex );
+};
+
+// Built in policies, MLFQ lives in Mlfq.c and the rest in Scheduler.c
+extern const struct SchedulerOps FCFS_N_SCHEDULER;
+extern const struct SchedulerOps SJF_N_SCHEDULER;
+extern const struct SchedulerOps SRTF_P_SCHEDULER;
+extern const struct SchedulerOps FCFS_P_SCHEDULER;
+extern const struct SchedulerOps RR_P_SCHEDULER;
+extern const struct SchedulerOps MLFQ_SCHEDULER;
+
+// Function headers
+const struct SchedulerOps *schedulerFor( int code );
+const char *schedulerName( int code );
+int schedulerCode( const char *name );
+
+// End include guard
+#endif              // SCHEDULER_H
@@ -0,0 +1,128 @@
+/**
+ * Name:
+ *      Sim04Top.c
+ *
+ * Desc:
+ *      Live viewer for a simulation started with --live-stats. Attaches to
+ *      the shared memory segment and redraws the counters until the
+ *      simulation finishes.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      Built with "make -f sim04_mf top". Usage: sim04top <name> [msec]
+ *      The viewer only reads the segment, the simulation never waits on
+ *      it, so any number of viewers can watch one run.
+ */
+
+// Include guard
+#ifndef SIM04TOP_C
+#define SIM04TOP_C
+
+// Include header
+#include <time.h>
+#include "LiveStats.h"
+#include "StringUtilities.h"
+
+// Refresh interval when none is given, in msec
+#define TOP_DEFAULT_INTERVAL  500
+
+static long long monotonicUsec( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+static void drawStats( char *name, const struct LiveStats *stats )
+{
+    /**
+     * Desc:
+     *      Redraw the screen with one snapshot of the counters.
+     *
+     * Args:
+     *      name (char*): segment name, for the title
+     *      stats (const struct LiveStats*): snapshot to show
+     */
+    long long now = monotonicUsec();
+
+    printf( "\033[H\033[J" );
+    printf( "sim04top  %s  pid %d  %s\n\n", name, stats->pid,
+            stats->running ? "running" : "finished" );
+    printf( "Simulated time    %14.6f s\n", stats->simulatedTime / 1000000.0 );
+    printf( "Wall time         %14.3f s   updated %.3f s ago\n",
+            ( stats->updatedAt - stats->startedAt ) / 1000000.0,
+            ( now - stats->updatedAt ) / 1000000.0 );
+    printf( "Events            %14lld   %.1f /s\n", stats->eventCount,
+            stats->eventsPerSecond );
+    printf( "Ops completed     %14lld\n", stats->opsCompleted );
+    printf( "Memory allocated  %14lld / %lld KB\n\n", stats->memoryUsed,
+            stats->memoryAvailable );
+
+    printf( "%-12s %8s\n", "State", "Processes" );
+    for( int state = 0; ( state ) < ( STATE_COUNT ); state++ )
+    {
+        printf( "%-12s %8d\n", PROCESS_STATE_NAMES[state],
+                stats->stateCounts[state] );
+    }
+
+    if( ( stats->runningProcess ) >= ( 0 ) )
+    {
+        printf( "On the CPU: Process %d\n", stats->runningProcess );
+    }
+
+    printf( "\n%-12s %8s\n", "Device", "Busy" );
+    for( int device = 0; ( device ) < ( DEVICE_COUNT ); device++ )
+    {
+        printf( "%-12s %4d / %d\n", DEVICE_NAMES[device],
+                stats->deviceBusy[device], stats->deviceChannels[device] );
+    }
+
+    fflush( stdout );
+}
+
+int main( int argc, char **argv )
+{
+    int interval = TOP_DEFAULT_INTERVAL;
+    const struct LiveStats *shared;
+    struct LiveStats snapshot;
+    struct timespec pause;
+
+    if( ( argc ) < ( 2 ) )
+    {
+        fprintf( stderr, "Usage: sim04top <name> [msec]\n" );
+        return -1;
+    }
+
+    if( ( argc ) > ( 2 ) && ( stringToInt( argv[2] ) ) > ( 0 ) )
+    {
+        interval = stringToInt( argv[2] );
+    }
+
+    shared = liveStatsAttach( argv[1] );
+
+    if( ( shared ) == ( NULL ) )
+    {
+        fprintf( stderr, "No simulation is publishing live stats as: %s\n",
+                 argv[1] );
+        return -1;
+    }
+
+    pause.tv_sec = interval / 1000;
+    pause.tv_nsec = ( interval % 1000 ) * 1000000L;
+
+    while( ( liveStatsRead( shared, &snapshot ) ) == ( 1 ) )
+    {
+        drawStats( argv[1], &snapshot );
+        nanosleep( &pause, NULL );
+    }
+
+    drawStats( argv[1], &snapshot );
+    liveStatsDetach( shared );
+    return 0;
+}
+
+// End include guard
+#endif              // SIM04TOP_C
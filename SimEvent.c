@@ -0,0 +1,163 @@
+/**
+ * Name:
+ *      SimEvent.c
+ *
+ * Desc:
+ *      Implementation of SimEvent.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef SIMEVENT_C
+#define SIMEVENT_C
+
+// Include header
+#include "SimEvent.h"
+#include "ProcessPcb.h"
+
+const char *PROCESS_STATE_NAMES[] = {"New", "Ready", "Running", "Waiting",
+                                     "Exit"};
+const char *EVENT_TYPE_NAMES[] = {"system_start", "pcb_creation", "all_new",
+                                  "all_ready", "process_selected",
+                                  "process_state", "seg_fault", "mmu_start",
+                                  "mmu_result", "op_start", "op_end",
+                                  "system_stop", "preempted", "swap_out",
+                                  "swap_in"};
+
+// Begin implementation
+void formatEvent( const struct SimEvent *event, CfgData *data, double time,
+                  char *logLine )
+{
+    /**
+     * Desc:
+     *      Format an event as a log line, exactly as the simulator has
+     *      always printed it.
+     *
+     * Args:
+     *      event (const struct SimEvent*): event to format
+     *      data (CfgData*): config, used for the strategy name and the
+     *                       cycle times of the selection estimate
+     *      time (double): timestamp of the event in seconds
+     *      logLine (char*): output buffer, at least BUFFER_SIZE chars
+     */
+    const char *opString = "";
+    const char *mmuOp = "Access";
+
+    // Names are only looked up here, everything else works on op codes
+    if( ( event->opIndex ) >= ( 0 ) )
+    {
+        opString = META_LEGAL_OP_STRINGS[event->opIndex];
+    }
+
+    if( ( event->opIndex ) == ( OP_ALLOCATE ) )
+    {
+        mmuOp = "Allocation";
+    }
+
+    switch( event->type )
+    {
+        case EVENT_SYSTEM_START:
+            sprintf( logLine, "Time:  %f, OS: System Start\n", time );
+            break;
+
+        case EVENT_PCB_CREATION:
+            sprintf( logLine, "Time:  %f, OS: Begin PCB Creation\n", time );
+            break;
+
+        case EVENT_ALL_NEW:
+            sprintf( logLine,
+                "Time:  %f, OS: All Processes initialized in New state\n",
+                time );
+            break;
+
+        case EVENT_ALL_READY:
+            sprintf( logLine,
+                "Time:  %f, OS: All Processes now set to Ready state\n",
+                time );
+            break;
+
+        case EVENT_PROCESS_SELECTED:
+            sprintf( logLine,
+                "Time:  %f, OS: %s Strategy selects Process %d with time: %lld mSec\n",
+                time,
+                schedulerName( data->cpuSchedulingCode ),
+                event->processId,
+                event->value * data->procCycleTime +
+                deviceIoTime( data, event->value2, event->deviceCycles ) );
+            break;
+
+        case EVENT_PROCESS_STATE:
+            sprintf( logLine, "Time:  %f, OS: Process %d set in %s state\n",
+                time,
+                event->processId,
+                PROCESS_STATE_NAMES[event->value] );
+            break;
+
+        case EVENT_SEG_FAULT:
+            sprintf( logLine,
+                "Time:  %f, OS: Process %d Segmentation Fault - Process ended\n",
+                time,
+                event->processId );
+            break;
+
+        case EVENT_MMU_START:
+            sprintf( logLine, "Time:  %f, Process %d, MMU %s: %lld/%lld/%lld start \n",
+                time,
+                event->processId,
+                mmuOp,
+                event->value / 1000000,
+                ( event->value / 1000 ) % 1000,
+                event->value % 1000 );
+            break;
+
+        case EVENT_MMU_RESULT:
+            sprintf( logLine, "Time:  %f, Process %d, MMU %s: %s\n",
+                time,
+                event->processId,
+                mmuOp,
+                event->value == 1 ? "Successful" : "Failed" );
+            break;
+
+        case EVENT_OP_START:
+        case EVENT_OP_END:
+            sprintf( logLine, "Time:  %f, Process %d, %s %s %s \n",
+                time,
+                event->processId,
+                opString,
+                event->component == 'I' ? "input" :
+                event->component == 'O' ? "output" : "operation",
+                event->type == EVENT_OP_START ? "start" : "end" );
+            break;
+
+        case EVENT_SYSTEM_STOP:
+            sprintf( logLine, "Time:  %f, OS: System stop\n", time );
+            break;
+
+        case EVENT_PREEMPTED:
+            sprintf( logLine, "Time:  %f, OS: Process %d preempted\n",
+                time,
+                event->processId );
+            break;
+
+        case EVENT_SWAP_OUT:
+        case EVENT_SWAP_IN:
+            sprintf( logLine,
+                "Time:  %f, OS: Process %d segment %lld/%lld/%lld swapped %s\n",
+                time,
+                event->processId,
+                event->value / 1000000,
+                ( event->value / 1000 ) % 1000,
+                event->value % 1000,
+                event->type == EVENT_SWAP_OUT ? "out" : "in" );
+            break;
+
+        default:
+            logLine[0] = '\0';
+            break;
+    }
+}
+
+// End include guard
+#endif              // SIMEVENT_C
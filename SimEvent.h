@@ -0,0 +1,66 @@
+/**
+ * Name:
+ *      SimEvent.h
+ *
+ * Desc:
+ *      Simulator events. Every line the simulator logs is described by one
+ *      of these events, so the same stream can be formatted for the log,
+ *      recorded to a trace, or replayed later.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef SIMEVENT_H
+#define SIMEVENT_H
+
+// Include header
+#include <stdio.h>
+#include "InputDataProcessor.h"
+
+// Event type codes
+enum SIM_EVENT_TYPES { EVENT_SYSTEM_START, EVENT_PCB_CREATION,
+                       EVENT_ALL_NEW, EVENT_ALL_READY,
+                       EVENT_PROCESS_SELECTED, EVENT_PROCESS_STATE,
+                       EVENT_SEG_FAULT, EVENT_MMU_START, EVENT_MMU_RESULT,
+                       EVENT_OP_START, EVENT_OP_END, EVENT_SYSTEM_STOP,
+                       EVENT_PREEMPTED, EVENT_SWAP_OUT, EVENT_SWAP_IN,
+                       EVENT_TYPE_COUNT };
+
+// Process state codes, index into PROCESS_STATE_NAMES
+enum PROCESS_STATES { STATE_NEW, STATE_READY, STATE_RUNNING, STATE_WAITING,
+                      STATE_EXIT, STATE_COUNT };
+
+extern const char *PROCESS_STATE_NAMES[];
+
+// Event type names for the machine readable logs, index by type
+extern const char *EVENT_TYPE_NAMES[];
+
+// Event struct
+//      processId is -1 for OS events. opIndex is the META_OP_CODES value
+//      of op events, -1 otherwise. value holds the op cycles, the MMU
+//      request, the MMU result (1/0) or the state code depending on type.
+//      For EVENT_PROCESS_SELECTED value and value2 hold the processor and
+//      I/O cycles of the selected process, and deviceCycles the I/O cycles
+//      split by DEVICE_CLASSES, so the time estimate can be recomputed for
+//      any cycle times. deviceCycles is NULL for every other event. For
+//      swap events processId owns the segment, value is the segment in MMU
+//      form and value2 is the process that waits for the swap.
+struct SimEvent
+{
+    int type;
+    int processId;
+    char component;
+    int opIndex;
+    long long value;
+    long long value2;
+    const long long *deviceCycles;
+};
+
+// Function headers
+void formatEvent( const struct SimEvent *event, CfgData *data, double time,
+                  char *logLine );
+
+// End include guard
+#endif              // SIMEVENT_H
@@ -0,0 +1,358 @@
+/**
+ * Name:
+ *      Swap.c
+ *
+ * Desc:
+ *      Implementation of Swap.h
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ *
+ * Notes:
+ *      There is one backing store per run, kept in this file the same way
+ *      Device.c keeps its devices. Victims are the least recently used
+ *      resident segments of other processes, the faulting process's own
+ *      segments are only taken when no other process has one. Every
+ *      transfer is a hard drive request, so it queues behind other I/O,
+ *      and the faulting process holds the CPU until its transfers finish.
+ */
+
+// Include guard
+#ifndef SWAP_C
+#define SWAP_C
+
+// Include header
+#include "Swap.h"
+#include "ProcessPcb.h"
+
+// Backing store state
+static int swapOn = 0;
+static long long memoryAvailable = 0;
+static long long swapSpace = 0;
+static long long kbPerCycle = 1;
+static long long residentKb = 0;
+static long long swappedKb = 0;
+static long long useClock = 0;
+static int *pendingSwaps = NULL;
+
+// Statistics
+static long long swapOuts = 0;
+static long long swapIns = 0;
+static long long kbOut = 0;
+static long long kbIn = 0;
+static long long waitTime = 0;
+
+static long long mmuValue( const struct MMU *block )
+{
+    // Segment, base and size packed the way M ops are written
+    return block->segment * 1000000LL + block->base * 1000LL +
+           block->requested;
+}
+
+static void swapTransfer( struct SimContext *context, int processIndex,
+                          struct MMU *block, int type )
+{
+    /**
+     * Desc:
+     *      Log a swap and queue its hard drive transfer for the waiting
+     *      process.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     *      processIndex (int): index of the process that waits
+     *      block (struct MMU*): segment being moved
+     *      type (int): EVENT_SWAP_OUT or EVENT_SWAP_IN
+     */
+    struct SimEvent event = { type, block->processId, 0, -1, mmuValue( block ),
+                              context->pcbArray[processIndex].processCounter,
+                              NULL };
+    long long cycles = ( block->requested + kbPerCycle - 1 ) / kbPerCycle;
+    long long service = cycles * deviceCycleTime( context->data,
+                                                  OP_HARD_DRIVE ) * 1000LL;
+
+    logEvent( &event, context->data, context->logFile, context->logLine,
+        context->timeBuffer );
+    deviceSubmit( DEVICE_HARD_DRIVE, processIndex, 1, service,
+                  simulatedTime() );
+    pendingSwaps[processIndex]++;
+}
+
+static struct MMU *findVictim( struct SimContext *context, int processIndex,
+                               const struct MMU *keep )
+{
+    /**
+     * Desc:
+     *      Least recently used resident segment, preferring segments of
+     *      other processes.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     *      processIndex (int): index of the faulting process
+     *      keep (const struct MMU*): segment that must stay, may be NULL
+     *
+     * Returns:
+     *      The victim, or NULL if nothing can be swapped out.
+     */
+    struct MMU *victim = NULL;
+    struct MMU *ownVictim = NULL;
+
+    for( int index = 0; ( index ) < ( context->arraySize ); index++ )
+    {
+        struct Memory *memory = context->pcbArray[index].memory;
+
+        if( ( memory ) == ( NULL ) )
+        {
+            continue;
+        }
+
+        for( memory = memory->next; ( memory ) != ( NULL );
+             memory = memory->next )
+        {
+            struct MMU *block = memory->block;
+            struct MMU **best = index == processIndex ? &ownVictim : &victim;
+
+            if( ( block->resident ) == ( 0 ) || ( block ) == ( keep ) )
+            {
+                continue;
+            }
+
+            if( ( *best ) == ( NULL ) || ( block->lastUse ) < ( (*best)->lastUse ) )
+            {
+                *best = block;
+            }
+        }
+    }
+
+    return victim != NULL ? victim : ownVictim;
+}
+
+static void swapWait( struct SimContext *context, int processIndex )
+{
+    // Idle the CPU until the process's transfers are done
+    while( ( pendingSwaps[processIndex] ) > ( 0 ) )
+    {
+        runUntil( context, devicesNextCompletion() );
+    }
+}
+
+static int makeRoom( struct SimContext *context, int processIndex,
+                     long long size, const struct MMU *keep )
+{
+    /**
+     * Desc:
+     *      Queue swap outs until size KB more fits in memory.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     *      processIndex (int): index of the faulting process
+     *      size (long long): KB that has to fit
+     *      keep (const struct MMU*): segment that must stay, may be NULL
+     *
+     * Returns:
+     *      1 if the memory fits once the transfers finish, otherwise 0.
+     */
+    if( ( size ) > ( memoryAvailable ) )
+    {
+        return 0;
+    }
+
+    while( ( residentKb + size ) > ( memoryAvailable ) )
+    {
+        struct MMU *victim = findVictim( context, processIndex, keep );
+
+        if( ( victim ) == ( NULL ) ||
+            ( swappedKb + victim->requested ) > ( swapSpace ) )
+        {
+            return 0;
+        }
+
+        swapTransfer( context, processIndex, victim, EVENT_SWAP_OUT );
+        victim->resident = 0;
+        residentKb -= victim->requested;
+        swappedKb += victim->requested;
+        swapOuts++;
+        kbOut += victim->requested;
+    }
+
+    return 1;
+}
+
+// Begin implementation
+int swapEnabled( void )
+{
+    /**
+     * Desc:
+     *      Whether memory is shared and swapped.
+     *
+     * Returns:
+     *      1 if swap space is configured, otherwise 0.
+     */
+    return swapOn;
+}
+
+void swapStart( CfgData *data, int arraySize )
+{
+    /**
+     * Desc:
+     *      Set up an empty backing store, dropping any previous statistics.
+     *
+     * Args:
+     *      data (CfgData*): config holding the memory and swap sizes
+     *      arraySize (int): number of processes
+     */
+    swapFree();
+
+    swapOn = data->swapSpace > 0;
+    memoryAvailable = data->memAvailable;
+    swapSpace = data->swapSpace;
+    kbPerCycle = data->swapKbPerCycle;
+    residentKb = 0;
+    swappedKb = 0;
+    useClock = 0;
+    pendingSwaps = calloc( arraySize > 0 ? arraySize : 1, sizeof( int ) );
+    swapOuts = 0;
+    swapIns = 0;
+    kbOut = 0;
+    kbIn = 0;
+    waitTime = 0;
+}
+
+int swapMakeRoom( struct SimContext *context, int processIndex,
+                  long long size )
+{
+    /**
+     * Desc:
+     *      Swap out other segments until a new segment fits in memory, and
+     *      wait for the transfers.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     *      processIndex (int): index of the allocating process
+     *      size (long long): KB of the new segment
+     *
+     * Returns:
+     *      1 if the segment fits, 0 if the memory or swap space ran out.
+     */
+    long long start = simulatedTime();
+    int fits = makeRoom( context, processIndex, size, NULL );
+
+    swapWait( context, processIndex );
+    waitTime += simulatedTime() - start;
+    return fits;
+}
+
+void swapResident( struct MMU *block )
+{
+    /**
+     * Desc:
+     *      Count a newly allocated segment as resident and used now.
+     *
+     * Args:
+     *      block (struct MMU*): segment that was allocated
+     */
+    block->resident = 1;
+    block->lastUse = ++useClock;
+    residentKb += block->requested;
+}
+
+int swapTouch( struct SimContext *context, int processIndex,
+               struct MMU *block )
+{
+    /**
+     * Desc:
+     *      Mark a segment used, swapping it back in first if it is out.
+     *
+     * Args:
+     *      context (struct SimContext*): run state
+     *      processIndex (int): index of the accessing process
+     *      block (struct MMU*): segment being accessed
+     *
+     * Returns:
+     *      1 if the segment is resident, 0 if it could not be brought in.
+     */
+    long long start = simulatedTime();
+
+    if( ( block->resident ) == ( 0 ) )
+    {
+        if( ( makeRoom( context, processIndex, block->requested, block ) )
+            == ( 0 ) )
+        {
+            swapWait( context, processIndex );
+            waitTime += simulatedTime() - start;
+            return 0;
+        }
+
+        swapTransfer( context, processIndex, block, EVENT_SWAP_IN );
+        block->resident = 1;
+        residentKb += block->requested;
+        swappedKb -= block->requested;
+        swapIns++;
+        kbIn += block->requested;
+        swapWait( context, processIndex );
+        waitTime += simulatedTime() - start;
+    }
+
+    block->lastUse = ++useClock;
+    return 1;
+}
+
+void swapComplete( int processIndex )
+{
+    /**
+     * Desc:
+     *      Note that one of a process's swap transfers finished.
+     *
+     * Args:
+     *      processIndex (int): index of the waiting process
+     */
+    pendingSwaps[processIndex]--;
+}
+
+void swapRelease( struct Memory *memory )
+{
+    /**
+     * Desc:
+     *      Give back the memory and swap space of a process's segments,
+     *      before they are freed.
+     *
+     * Args:
+     *      memory (struct Memory*): head of the process's segment list
+     */
+    for( memory = memory->next; ( memory ) != ( NULL ); memory = memory->next )
+    {
+        if( memory->block->resident )
+        {
+            residentKb -= memory->block->requested;
+        }
+        else
+        {
+            swappedKb -= memory->block->requested;
+        }
+    }
+}
+
+void swapPrintStats( void )
+{
+    /**
+     * Desc:
+     *      Print the swap counts, the KB moved and the simulated time
+     *      processes spent waiting for swap transfers.
+     */
+    printf( "\n___________SWAP STATS___________\n" );
+    printf( "Swap Outs           : %lld (%lld KB)\n", swapOuts, kbOut );
+    printf( "Swap Ins            : %lld (%lld KB)\n", swapIns, kbIn );
+    printf( "Swap Wait           : %.3f mSec\n", waitTime / 1000.0 );
+}
+
+void swapFree( void )
+{
+    /**
+     * Desc:
+     *      Free the pending transfer counts.
+     */
+    free( pendingSwaps );
+    pendingSwaps = NULL;
+}
+
+// End include guard
+#endif              // SWAP_C
@@ -0,0 +1,43 @@
+/**
+ * Name:
+ *      Swap.h
+ *
+ * Desc:
+ *      Swapping to a simulated backing store on the hard drive. With swap
+ *      space configured, memory is shared by every process up to the
+ *      memory available, and segments are moved out and back in through
+ *      the hard drive instead of failing allocations.
+ *
+ * Version:
+ *      1.00 (19 Oct 2026)
+ */
+
+// Include guard
+#ifndef SWAP_H
+#define SWAP_H
+
+// Include header
+#include <stdio.h>
+#include <stdlib.h>
+#include "InputDataProcessor.h"
+
+// Defined in ProcessPcb.h
+struct SimContext;
+struct MMU;
+struct Memory;
+
+// Function headers
+int swapEnabled( void );
+void swapStart( CfgData *data, int arraySize );
+int swapMakeRoom( struct SimContext *context, int processIndex,
+                  long long size );
+void swapResident( struct MMU *block );
+int swapTouch( struct SimContext *context, int processIndex,
+               struct MMU *block );
+void swapComplete( int processIndex );
+void swapRelease( struct Memory *memory );
+void swapPrintStats( void );
+void swapFree( void );
+
+// End include guard
+#endif              // SWAP_H
@@ -33,53 +33,142 @@ const int False = 0;
 const int True = 1;
 const char NULL_CHAR = '\0';
 
-void runTimer( int milliSeconds )
+// Simulated clock, moved only by advanceTimer. The virtual timer reports
+// this clock, the real timer also waits for each advance.
+static int timerMode = REAL_TIMER;
+static long long simulatedUSec = 0;
+
+// Overshoot statistics for real time waits, kept by the simulation thread
+static long long waitCount = 0;
+static long long overshootTotalNSec = 0;
+static long long overshootMaxNSec = 0;
+
+void setTimerMode( int mode )
+   {
+    timerMode = mode;
+    simulatedUSec = 0;
+   }
+
+void runTimer( long long milliSeconds )
+   {
+    advanceTimer( milliSeconds * 1000 );
+   }
+
+void advanceTimer( long long microSeconds )
+   {
+    // Simulated time never runs backwards, in either mode
+    if( microSeconds <= 0 )
+       {
+        return;
+       }
+
+    simulatedUSec = simulatedUSec + microSeconds;
+
+    if( timerMode == REAL_TIMER )
+       {
+        waitMicroSeconds( microSeconds );
+       }
+   }
+
+long long simulatedTime( void )
    {
-    struct timeval startTime, endTime;
-    int startSec, startUSec, endSec, endUSec;
-    int uSecDiff, mSecDiff, secDiff, timeDiff;
+    return simulatedUSec;
+   }
 
-    gettimeofday( &startTime, NULL );
+/* Sleeps until shortly before the deadline, then spins for the last
+   TIMER_SPIN_WINDOW_USEC so the wake up latency of the sleep does not
+   show up as overshoot; a wait no longer than the window just spins
+*/
+void waitMicroSeconds( long long microSeconds )
+   {
+    struct timespec deadline, wakeTime, now;
+    long long overshootNSec;
 
-    startSec = startTime.tv_sec;
-    startUSec = startTime.tv_usec;
+    clock_gettime( CLOCK_MONOTONIC, &deadline );
 
-    timeDiff = 0;
+    deadline.tv_sec += microSeconds / 1000000;
+    deadline.tv_nsec += ( microSeconds % 1000000 ) * 1000;
 
-    while( timeDiff < milliSeconds )
+    if( deadline.tv_nsec >= 1000000000 )
        {
-        gettimeofday( &endTime, NULL );
+        deadline.tv_nsec -= 1000000000;
+        deadline.tv_sec++;
+       }
 
-        endSec = endTime.tv_sec;
-        endUSec = endTime.tv_usec;
-        uSecDiff = endUSec - startUSec;
+    if( microSeconds > TIMER_SPIN_WINDOW_USEC )
+       {
+        wakeTime = deadline;
+        wakeTime.tv_nsec -= TIMER_SPIN_WINDOW_USEC * 1000;
 
-        if( uSecDiff < 0 )
+        if( wakeTime.tv_nsec < 0 )
            {
-            uSecDiff = uSecDiff + 1000000;
+            wakeTime.tv_nsec += 1000000000;
+            wakeTime.tv_sec--;
+           }
 
-            endSec = endSec - 1;
+        while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                &wakeTime, NULL ) == EINTR )
+           {
            }
+       }
 
-        mSecDiff = uSecDiff / 1000;
-        secDiff = ( endSec - startSec ) * 1000;
-        timeDiff = secDiff + mSecDiff;
+    do
+       {
+        clock_gettime( CLOCK_MONOTONIC, &now );
+
+        overshootNSec = ( now.tv_sec - deadline.tv_sec ) * 1000000000LL
+                                           + ( now.tv_nsec - deadline.tv_nsec );
+       }
+    while( overshootNSec < 0 );
+
+    waitCount++;
+    overshootTotalNSec += overshootNSec;
+
+    if( overshootNSec > overshootMaxNSec )
+       {
+        overshootMaxNSec = overshootNSec;
+       }
+   }
+
+void printTimerStats( void )
+   {
+    printf( "\n___________TIMER STATS___________\n" );
+    printf( "Waits               : %lld\n", waitCount );
+
+    if( waitCount > 0 )
+       {
+        printf( "Mean Overshoot      : %.3f uSec\n",
+                (double) overshootTotalNSec / waitCount / 1000 );
+        printf( "Max Overshoot       : %.3f uSec\n",
+                (double) overshootMaxNSec / 1000 );
        }
    }
 
 double accessTimer( int controlCode, char *timeStr )
    {
     static int running = 0;
-    static int startSec = 0, endSec = 0, startUSec = 0, endUSec = 0;
-    static int lapSec = 0, lapUSec = 0;
+    static long long startSec = 0, endSec = 0, startUSec = 0, endUSec = 0;
+    static long long lapSec = 0, lapUSec = 0;
     struct timeval startData, lapData, endData;
     double fpTime = 0.0;
 
+    if( timerMode == VIRTUAL_TIMER )
+       {
+        if( controlCode == ZERO_TIMER )
+           {
+            simulatedUSec = 0;
+           }
+
+        return processTime( 0, simulatedUSec / 1000000,
+                            0, simulatedUSec % 1000000, timeStr );
+       }
+
     switch( controlCode )
        {
         case ZERO_TIMER:
            gettimeofday( &startData, NULL );
            running = True;
+           simulatedUSec = 0;
 
            startSec = startData.tv_sec;
            startUSec = startData.tv_usec;
@@ -159,7 +248,7 @@ double processTime( double startSec, double endSec,
    when printed as a string; this will not always be the case
    if the time is presented as a floating point number
 */
-void timeToString( int secTime, int uSecTime, char *timeStr )
+void timeToString( long long secTime, long long uSecTime, char *timeStr )
    {
     int low, high, index = 0;
     char temp;
@@ -22,6 +22,9 @@
 // Header files ///////////////////////////////////////////////////////////////
 
 #include <sys/time.h>
+#include <time.h>
+#include <errno.h>
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
 
@@ -29,14 +32,24 @@
 
 enum TIMER_CTRL_CODES { ZERO_TIMER, LAP_TIMER, STOP_TIMER };
 
+enum TIMER_MODES { REAL_TIMER, VIRTUAL_TIMER };
+
+// Final part of a real time wait that is spun instead of slept
+#define TIMER_SPIN_WINDOW_USEC 200
+
 //extern const char RADIX_POINT;
 
 // Function Prototyp  /////////////////////////////////////////////////////////
 
-void runTimer( int milliSeconds );
+void setTimerMode( int mode );
+void runTimer( long long milliSeconds );
+void advanceTimer( long long microSeconds );
+long long simulatedTime( void );
+void waitMicroSeconds( long long microSeconds );
+void printTimerStats( void );
 double accessTimer( int controlCode, char *timeStr );
 double processTime( double startSec, double endSec,
                            double startUSec, double endUSec, char *timeStr );
-void timeToString( int secTime, int uSecTime, char *timeStr );
+void timeToString( long long secTime, long long uSecTime, char *timeStr );
 
 #endif // ifndef SIMTIMER_H